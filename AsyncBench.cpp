@@ -0,0 +1,92 @@
+//    AsyncMSQueue ( C++20): consumers     co_await pop_async,
+// producers   .    itemsPerConsumer   .
+//     ,  tid   thread_local.
+//  : 0 -      , 1 - , 2 -  .
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LFQueue/AsyncMSQueue.hpp"
+
+using namespace std;
+
+static thread_local int currentTid = 0;
+
+//   :        
+struct Detached {
+	struct promise_type {
+		Detached get_return_object() { return {}; }
+		suspend_never initial_suspend() { return {}; }
+		suspend_never final_suspend() noexcept { return {}; }
+		void return_void() { }
+		void unhandled_exception() { terminate(); }
+	};
+};
+
+static Detached consume(AsyncMSQueue<unsigned long long>& queue, unsigned items,
+	atomic<unsigned long long>& sum, atomic<unsigned>& finished) {
+	unsigned long long local = 0;
+	for (unsigned i = 0; i < items; i++) {
+		unsigned long long* item = co_await queue.pop_async(currentTid);
+		local += *item;
+	}
+	sum.fetch_add(local);
+	finished.fetch_add(1);
+}
+
+int main(int argc, char* argv[]) {
+	unsigned consumers = 4, producers = 4, itemsPerConsumer = 100000;
+	if (argc > 1) consumers = (unsigned)atoi(argv[1]);
+	if (argc > 2) producers = (unsigned)atoi(argv[2]);
+	if (argc > 3) itemsPerConsumer = (unsigned)atoi(argv[3]);
+	if (consumers == 0 || producers == 0 || producers + 1 > 128 || itemsPerConsumer % producers != 0) {
+		cerr << "usage: " << argv[0] << " [consumers] [producers < 128] [items per consumer, multiple of producers]" << endl;
+		return 2;
+	}
+
+	const unsigned long long total = (unsigned long long)consumers * itemsPerConsumer;
+	vector<unsigned long long> values(total);
+	for (unsigned long long i = 0; i < total; i++) values[i] = i;
+	atomic<unsigned long long> sum(0);
+	atomic<unsigned> finished(0);
+	atomic<bool> start(false);
+	double seconds;
+	{
+		AsyncMSQueue<unsigned long long> queue;
+		currentTid = (int)producers;		//        tid
+		for (unsigned c = 0; c < consumers; c++)
+			consume(queue, itemsPerConsumer, sum, finished);
+
+		vector<thread> workers;
+		const unsigned long long perProducer = total / producers;
+		for (unsigned p = 0; p < producers; p++)
+			workers.emplace_back([&, p]() {
+				currentTid = (int)p;
+				while (!start.load(memory_order_acquire)) this_thread::yield();
+				for (unsigned long long i = p * perProducer; i < (p + 1) * perProducer; i++)
+					queue.push(&values[i], (int)p);
+			});
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		for (auto& t : workers) t.join();
+		seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		//   ,     :     
+	}
+
+	unsigned long long expected = total * (total - 1) / 2;
+	cout << "AsyncMSQueue: " << consumers << " coroutines x " << itemsPerConsumer << " co_await, " << producers
+		 << " producers, " << total / seconds / 1e6 << " M items/s" << endl;
+	if (finished.load() != consumers || sum.load() != expected) {
+		cout << "MISMATCH: finished " << finished.load() << " of " << consumers << ", sum " << sum.load()
+			 << " expected " << expected << endl;
+		return 1;
+	}
+	cout << "ok" << endl;
+	return 0;
+}
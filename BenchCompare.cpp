@@ -0,0 +1,330 @@
+//     LockFreeQueue --json.
+//    (, , , ,  )  
+//    t- .  -      p < alpha.
+//  : 0 -  , 1 -        ,
+// 2 -     (       ).
+
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+struct JsonValue {
+	//   JSON,    
+	enum Type { Null, Bool, Number, String, Array, Object } type = Null;
+	double number = 0;
+	string text;
+	vector<JsonValue> items;
+	vector<pair<string, JsonValue>> fields;
+
+	const JsonValue* get(const string& name) const {
+		for (auto& field : fields)
+			if (field.first == name) return &field.second;
+		return nullptr;
+	}
+};
+
+class JsonParser {
+	//   JSON.    runtime_error  .
+	const string& src;
+	size_t pos = 0;
+
+	void fail(const string& what) {
+		throw runtime_error("JSON: " + what + " at offset " + to_string(pos));
+	}
+
+	void skipSpaces() {
+		while (pos < src.size() && isspace((unsigned char)src[pos])) pos++;
+	}
+
+	void expect(char c) {
+		skipSpaces();
+		if (pos >= src.size() || src[pos] != c) fail(string("expected '") + c + "'");
+		pos++;
+	}
+
+	string parseString() {
+		expect('"');
+		string out;
+		while (pos < src.size() && src[pos] != '"') {
+			char c = src[pos++];
+			if (c == '\\') {
+				if (pos >= src.size()) fail("bad escape");
+				char e = src[pos++];
+				switch (e) {
+				case 'n': out += '\n'; break;
+				case 't': out += '\t'; break;
+				case 'r': out += '\r'; break;
+				case 'b': out += '\b'; break;
+				case 'f': out += '\f'; break;
+				case 'u': out += '?'; pos += 4; break;	// -ASCII     
+				default: out += e;
+				}
+			}
+			else out += c;
+		}
+		if (pos >= src.size()) fail("unterminated string");
+		pos++;
+		return out;
+	}
+
+	JsonValue parseValue() {
+		skipSpaces();
+		if (pos >= src.size()) fail("unexpected end");
+		JsonValue value;
+		char c = src[pos];
+		if (c == '{') {
+			value.type = JsonValue::Object;
+			pos++;
+			skipSpaces();
+			if (src[pos] == '}') { pos++; return value; }
+			while (true) {
+				string name = parseString();
+				expect(':');
+				value.fields.push_back(make_pair(name, parseValue()));
+				skipSpaces();
+				if (pos < src.size() && src[pos] == ',') { pos++; continue; }
+				expect('}');
+				return value;
+			}
+		}
+		if (c == '[') {
+			value.type = JsonValue::Array;
+			pos++;
+			skipSpaces();
+			if (src[pos] == ']') { pos++; return value; }
+			while (true) {
+				value.items.push_back(parseValue());
+				skipSpaces();
+				if (pos < src.size() && src[pos] == ',') { pos++; continue; }
+				expect(']');
+				return value;
+			}
+		}
+		if (c == '"') {
+			value.type = JsonValue::String;
+			value.text = parseString();
+			return value;
+		}
+		if (src.compare(pos, 4, "true") == 0) { value.type = JsonValue::Bool; value.number = 1; pos += 4; return value; }
+		if (src.compare(pos, 5, "false") == 0) { value.type = JsonValue::Bool; pos += 5; return value; }
+		if (src.compare(pos, 4, "null") == 0) { pos += 4; return value; }
+		size_t end = pos;
+		while (end < src.size() && (isdigit((unsigned char)src[end]) || (src[end] != 0 && strchr("+-.eE", src[end]) != nullptr))) end++;
+		if (end == pos) fail("unexpected character");
+		value.type = JsonValue::Number;
+		value.number = stod(src.substr(pos, end - pos));
+		pos = end;
+		return value;
+	}
+
+public:
+	JsonParser(const string& text) : src{ text } { }
+
+	JsonValue parse() {
+		JsonValue value = parseValue();
+		skipSpaces();
+		if (pos != src.size()) fail("trailing data");
+		return value;
+	}
+};
+
+struct RunSamples {
+	vector<double> throughput;
+
+	double mean() const {
+		double sum = 0;
+		for (double x : throughput) sum += x;
+		return sum / throughput.size();
+	}
+
+	double variance() const {
+		double m = mean(), sum = 0;
+		for (double x : throughput) sum += (x - m) * (x - m);
+		return sum / (throughput.size() - 1);
+	}
+
+	double median() const {
+		vector<double> sorted(throughput);
+		sort(sorted.begin(), sorted.end());
+		size_t mid = sorted.size() / 2;
+		return sorted.size() % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+	}
+};
+
+//      -
+static double betaContinuedFraction(double a, double b, double x) {
+	const double tiny = 1e-300;
+	double qab = a + b, qap = a + 1, qam = a - 1;
+	double c = 1, d = 1 - qab * x / qap;
+	if (fabs(d) < tiny) d = tiny;
+	d = 1 / d;
+	double h = d;
+	for (int m = 1; m <= 200; m++) {
+		int m2 = 2 * m;
+		double aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+		d = 1 + aa * d;
+		if (fabs(d) < tiny) d = tiny;
+		c = 1 + aa / c;
+		if (fabs(c) < tiny) c = tiny;
+		d = 1 / d;
+		h *= d * c;
+		aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+		d = 1 + aa * d;
+		if (fabs(d) < tiny) d = tiny;
+		c = 1 + aa / c;
+		if (fabs(c) < tiny) c = tiny;
+		d = 1 / d;
+		double del = d * c;
+		h *= del;
+		if (fabs(del - 1) < 1e-12) break;
+	}
+	return h;
+}
+
+//   - I_x(a, b)
+static double incompleteBeta(double a, double b, double x) {
+	if (x <= 0) return 0;
+	if (x >= 1) return 1;
+	double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1 - x));
+	if (x < (a + 1) / (a + b + 2))
+		return front * betaContinuedFraction(a, b, x) / a;
+	return 1 - front * betaContinuedFraction(b, a, 1 - x) / b;
+}
+
+// P(T > t)     df  
+static double studentUpperTail(double t, double df) {
+	double tail = 0.5 * incompleteBeta(df / 2, 0.5, df / (df + t * t));
+	return t >= 0 ? tail : 1 - tail;
+}
+
+//  t- :        
+static double welchRegressionPValue(const RunSamples& before, const RunSamples& after) {
+	double n1 = before.throughput.size(), n2 = after.throughput.size();
+	double v1 = before.variance() / n1, v2 = after.variance() / n2;
+	double diff = before.mean() - after.mean();
+	if (v1 + v2 == 0) return diff > 0 ? 0 : 1;
+	double t = diff / sqrt(v1 + v2);
+	double df = (v1 + v2) * (v1 + v2) / (v1 * v1 / (n1 - 1) + v2 * v2 / (n2 - 1));
+	return studentUpperTail(t, df);
+}
+
+static map<string, RunSamples> loadRuns(const string& path) {
+	ifstream in(path);
+	if (!in) throw runtime_error("can not open " + path);
+	stringstream buffer;
+	buffer << in.rdbuf();
+	string text = buffer.str();
+	JsonValue root = JsonParser(text).parse();
+	const JsonValue* runs = root.get("runs");
+	if (runs == nullptr || runs->type != JsonValue::Array) throw runtime_error(path + ": no \"runs\" array");
+
+	map<string, RunSamples> result;
+	for (auto& run : runs->items) {
+		const JsonValue* benchmark = run.get("benchmark");
+		const JsonValue* queue = run.get("queue");
+		const JsonValue* writers = run.get("writers");
+		const JsonValue* readers = run.get("readers");
+		const JsonValue* throughput = run.get("throughput");
+		if (!benchmark || !queue || !writers || !readers || !throughput)
+			throw runtime_error(path + ": incomplete run entry");
+		string key = benchmark->text + " " + queue->text + " W=" + to_string((int)writers->number)
+			+ " R=" + to_string((int)readers->number);
+		// ,    ,   
+		const JsonValue* requested = run.get("requested_threads");
+		if (requested != nullptr) key += " N=" + to_string((int)requested->number);
+		RunSamples& samples = result[key];
+		if (!samples.throughput.empty()) throw runtime_error(path + ": duplicate run " + key);
+		for (auto& value : throughput->items)
+			samples.throughput.push_back(value.number);
+	}
+	return result;
+}
+
+//    name; invalid_argument,  value   
+static double parseNumber(const string& name, const string& value) {
+	size_t end = 0;
+	double parsed = 0;
+	try {
+		parsed = stod(value, &end);
+	}
+	catch (const exception&) {
+		end = 0;
+	}
+	if (end == 0 || end != value.size()) throw invalid_argument(name + ": expected a number, got '" + value + "'");
+	return parsed;
+}
+
+int main(int argc, char* argv[]) {
+	double threshold = 0.05;	//    
+	double alpha = 0.05;		//  
+	vector<string> files;
+	map<string, RunSamples> before, after;
+	try {
+		for (int i = 1; i < argc; i++) {
+			string arg = argv[i];
+			if (arg == "--threshold" && i + 1 < argc) threshold = parseNumber(arg, argv[++i]);
+			else if (arg == "--alpha" && i + 1 < argc) alpha = parseNumber(arg, argv[++i]);
+			else files.push_back(arg);
+		}
+		if (files.size() != 2) {
+			cerr << "usage: " << argv[0] << " <baseline.json> <candidate.json> [--threshold 0.05] [--alpha 0.05]" << endl;
+			return 2;
+		}
+		before = loadRuns(files[0]);
+		after = loadRuns(files[1]);
+	}
+	catch (const exception& error) {
+		cerr << error.what() << endl;
+		return 2;
+	}
+
+	int regressions = 0, missing = 0;
+	cout << left << setw(40) << "run" << right << setw(14) << "baseline" << setw(14) << "candidate"
+		 << setw(10) << "change" << setw(10) << "p" << "  verdict" << endl;
+	for (auto& entry : before) {
+		auto found = after.find(entry.first);
+		if (found == after.end()) {
+			cout << left << setw(40) << entry.first << "  MISSING in candidate" << endl;
+			missing++;
+			continue;
+		}
+		const RunSamples& a = entry.second;
+		const RunSamples& b = found->second;
+		if (a.throughput.empty() || b.throughput.empty()) continue;
+		double change = b.median() / a.median() - 1;
+		string verdict = "ok";
+		double p = 1;
+		if (a.throughput.size() < 2 || b.throughput.size() < 2)
+			verdict = "too few repeats";
+		else {
+			p = welchRegressionPValue(a, b);
+			if (change < -threshold && p < alpha) {
+				verdict = "REGRESSION";
+				regressions++;
+			}
+			else if (change > threshold && 1 - p < alpha)
+				verdict = "improved";
+		}
+		cout << left << setw(40) << entry.first << right << fixed << setprecision(0)
+			 << setw(14) << a.median() << setw(14) << b.median()
+			 << setprecision(1) << setw(9) << change * 100 << "%"
+			 << setprecision(3) << setw(10) << p << "  " << verdict << endl;
+	}
+	for (auto& entry : after)
+		if (before.find(entry.first) == before.end())
+			cout << left << setw(40) << entry.first << "  new in candidate" << endl;
+
+	cout << regressions << " regression(s), " << missing << " run(s) missing in candidate" << endl;
+	return regressions != 0 || missing != 0 ? 1 : 0;
+}
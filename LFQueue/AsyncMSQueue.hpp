@@ -0,0 +1,166 @@
+#ifndef _ASYNC_MS_QUEUE_H_
+#define _ASYNC_MS_QUEUE_H_
+
+//  C++20 ().      .
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include "MSQueue.hpp"
+
+
+template<typename T>
+class AsyncMSQueue {
+    /*
+    //    MSQueue  .
+    // co_await q.pop_async(tid)   ,   ,  
+    //      (MSQueue<Waiter>).  push    
+    // ,    ,     executor.
+    //
+    // tid  pop_async -  ,    co_await.   
+    //    executor'     tid.
+    //
+    //     .       :  
+    // ,    (,  )  . , 
+    //  ,      -     .
+    */
+public:
+    using Executor = std::function<void(std::coroutine_handle<>)>;
+
+private:
+    enum WaiterState { WAITING, CLAIMED, CANCELLED };
+
+    struct Waiter {
+        std::coroutine_handle<> handle;
+        T* item = nullptr;                      // ,  
+        std::atomic<int> state{ WAITING };
+        // : awaiter, await_suspend    (  ,   )
+        std::atomic<int> refs{ 3 };
+
+        void release() {
+            if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+        }
+
+        //    
+        bool claim() {
+            int expected = WAITING;
+            return state.compare_exchange_strong(expected, CLAIMED);
+        }
+
+        //    ,    
+        bool cancel() {
+            int expected = WAITING;
+            return state.compare_exchange_strong(expected, CANCELLED);
+        }
+    };
+
+    MSQueue<T> items;
+    MSQueue<Waiter> waiters;
+    Executor executor;
+
+    //    ,   
+    void resumeWaiter(const int tid) {
+        while (true) {
+            Waiter* waiter = waiters.pop(tid);
+            if (waiter == nullptr) return;
+            if (!waiter->claim()) {
+                waiter->release();      //  
+                continue;
+            }
+            T* item = items.pop(tid);
+            if (item != nullptr) {
+                waiter->item = item;
+                std::coroutine_handle<> handle = waiter->handle;
+                waiter->release();
+                if (executor) executor(handle);
+                else handle.resume();
+                return;
+            }
+            //      -    .
+            //       ,   :   
+            //   ,     .
+            waiter->state.store(WAITING);
+            waiters.push(waiter, tid);
+            if (items.isEmpty()) return;
+        }
+    }
+
+public:
+    class PopAwaiter {
+        AsyncMSQueue& queue;
+        const int tid;
+        T* result = nullptr;
+        Waiter* waiter = nullptr;
+
+    public:
+        PopAwaiter(AsyncMSQueue& queue, const int tid) : queue{ queue }, tid{ tid } { }
+        PopAwaiter(const PopAwaiter&) = delete;
+
+        ~PopAwaiter() {
+            if (waiter != nullptr) waiter->release();
+        }
+
+        //  :   ,   
+        bool await_ready() {
+            result = queue.items.pop(tid);
+            return result != nullptr;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            //    waiters     ,
+            //      
+            AsyncMSQueue& q = queue;
+            const int t = tid;
+            Waiter* w = new Waiter;
+            w->handle = handle;
+            waiter = w;
+            q.waiters.push(w, t);
+
+            //      ,   
+            //       
+            T* item = q.items.pop(t);
+            if (item != nullptr) {
+                if (w->cancel()) {
+                    result = item;      //    ,   
+                    w->release();
+                    return false;
+                }
+                q.push(item, t);        //      
+            }
+            w->release();
+            return true;
+        }
+
+        T* await_resume() {
+            return result != nullptr ? result : waiter->item;
+        }
+    };
+
+    AsyncMSQueue(Executor executor = Executor(), int maxThreads = 128)
+        : items{ maxThreads }, waiters{ maxThreads }, executor{ executor } { }
+
+    //   ;        (. )
+    ~AsyncMSQueue() {
+        while (Waiter* waiter = waiters.pop(0))
+            waiter->release();
+    }
+
+    void push(T* item, const int tid) {
+        items.push(item, tid);
+        resumeWaiter(tid);
+    }
+
+    //  ,  MSQueue::pop
+    T* pop(const int tid) {
+        return items.pop(tid);
+    }
+
+    PopAwaiter pop_async(const int tid) {
+        return PopAwaiter(*this, tid);
+    }
+};
+
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,264 @@
+#ifndef _BASELINE_QUEUES_H_
+#define _BASELINE_QUEUES_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+#include "CacheAligned.hpp"
+
+
+//  ()     MSQueue  .
+//    MSQueue: push(item, tid) / pop(tid), tid .
+//    -      -    .
+
+template<typename T>
+class MutexQueue {
+    /*
+    // std::queue,   std::mutex
+    */
+private:
+    std::mutex lock;
+    std::queue<T*> items;
+
+public:
+    MutexQueue(int maxThreads = 0) { }
+
+    void push(T* item, const int tid) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        std::lock_guard<std::mutex> guard(lock);
+        items.push(item);
+    }
+
+    T* pop(const int tid) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (items.empty()) return nullptr;
+        T* item = items.front();
+        items.pop();
+        return item;
+    }
+};
+
+
+template<typename T>
+class TwoLockQueue {
+    /*
+    //  -   :       ,
+    //        
+    */
+private:
+    struct Node {
+        T* item;
+        std::atomic<Node*> next;
+
+        Node(T* userItem) : item{ userItem }, next{ nullptr } { }
+    };
+
+    alignas(128) std::mutex headLock;
+    Node* head;
+    alignas(128) std::mutex tailLock;
+    Node* tail;
+
+public:
+    TwoLockQueue(int maxThreads = 0) {
+        head = tail = new Node(nullptr);
+    }
+
+    ~TwoLockQueue() {
+        while (head != nullptr) {
+            Node* node = head;
+            head = node->next.load(std::memory_order_relaxed);
+            delete node;
+        }
+    }
+
+    void push(T* item, const int tid) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        Node* newNode = new Node(item);
+        std::lock_guard<std::mutex> guard(tailLock);
+        // next      pop,     release
+        tail->next.store(newNode, std::memory_order_release);
+        tail = newNode;
+    }
+
+    T* pop(const int tid) {
+        Node* node;
+        T* item;
+        {
+            std::lock_guard<std::mutex> guard(headLock);
+            node = head;
+            Node* lnext = node->next.load(std::memory_order_acquire);
+            if (lnext == nullptr) return nullptr;   //  
+            item = lnext->item;
+            head = lnext;
+        }
+        delete node;
+        return item;
+    }
+};
+
+
+template<typename T>
+class SpinRingQueue {
+    /*
+    //      -.
+    //   push   .
+    */
+private:
+    static const unsigned DEFAULT_CAPACITY = 1 << 16;
+
+    alignas(128) std::atomic_flag busy = ATOMIC_FLAG_INIT;
+    T** ring;
+    const unsigned mask;
+    unsigned first = 0;     //   
+    unsigned count = 0;     //  
+
+    void lock() {
+        unsigned spins = 0;
+        while (busy.test_and_set(std::memory_order_acquire))
+            if (++spins % 64 == 0) std::this_thread::yield();
+    }
+
+    void unlock() {
+        busy.clear(std::memory_order_release);
+    }
+
+public:
+    // capacity     
+    SpinRingQueue(int maxThreads = 0, unsigned capacity = DEFAULT_CAPACITY) : mask{ roundUp(capacity) - 1 } {
+        ring = new T*[mask + 1];
+    }
+
+    ~SpinRingQueue() {
+        delete[] ring;
+    }
+
+    static unsigned roundUp(unsigned value) {
+        unsigned size = 1;
+        while (size < value) size <<= 1;
+        return size;
+    }
+
+    void push(T* item, const int tid) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        while (true) {
+            lock();
+            if (count <= mask) {
+                ring[(first + count) & mask] = item;
+                count++;
+                unlock();
+                return;
+            }
+            unlock();
+            std::this_thread::yield();  //  
+        }
+    }
+
+    T* pop(const int tid) {
+        lock();
+        if (count == 0) {
+            unlock();
+            return nullptr;
+        }
+        T* item = ring[first];
+        first = (first + 1) & mask;
+        count--;
+        unlock();
+        return item;
+    }
+};
+
+
+template<typename K, typename T, typename Compare = std::less<K>>
+class MutexHeapQueue {
+    /*
+    //        SkipListPriorityQueue:  
+    // (std::priority_queue)   std::mutex. pop     .
+    */
+private:
+    struct Entry {
+        K key;
+        T* item;
+    };
+
+    struct Greater {
+        Compare less;
+        bool operator()(const Entry& a, const Entry& b) const {
+            return less(b.key, a.key);
+        }
+    };
+
+    std::mutex lock;
+    std::priority_queue<Entry, std::vector<Entry>, Greater> items;
+
+public:
+    MutexHeapQueue(int maxThreads = 0) { }
+
+    void push(const K& key, T* item, const int tid) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        std::lock_guard<std::mutex> guard(lock);
+        items.push(Entry{ key, item });
+    }
+
+    T* pop(const int tid, K* key = nullptr) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (items.empty()) return nullptr;
+        Entry top = items.top();
+        items.pop();
+        if (key != nullptr) *key = top.key;
+        return top.item;
+    }
+};
+
+
+template<typename K, typename V, typename Hash = std::hash<K>>
+class ShardedMutexMap {
+    /*
+    //  -    LockFreeHashMap: shards  std::unordered_map,
+    //    std::mutex.    LockFreeHashMap, tid .
+    */
+private:
+    struct alignas(128) Shard : CacheAligned {
+        std::mutex lock;
+        std::unordered_map<K, V, Hash> items;
+    };
+
+    Hash hasher;
+    const size_t shardCount;
+    std::unique_ptr<Shard[]> shards;
+
+    Shard& shardOf(const K& key) {
+        return shards[hasher(key) % shardCount];
+    }
+
+public:
+    ShardedMutexMap(int /*maxThreads*/ = 0, size_t shards = 64) : shardCount{ shards }, shards{ new Shard[shards] } { }
+
+    bool insert(const K& key, const V& value, const int /*tid*/) {
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        return shard.items.emplace(key, value).second;
+    }
+
+    bool find(const K& key, V& value, const int /*tid*/) {
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto it = shard.items.find(key);
+        if (it == shard.items.end()) return false;
+        value = it->second;
+        return true;
+    }
+
+    bool erase(const K& key, const int /*tid*/) {
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        return shard.items.erase(key) != 0;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,137 @@
+#ifndef _BROADCAST_RING_H_
+#define _BROADCAST_RING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+template<typename T>
+class BroadcastRing {
+    /*
+    //          Disruptor:  
+    //   .      ,     .
+    //
+    //   ,  cursor.      -  
+    //  .          capacity.
+    //     :    ,     
+    //    (B   ,  A ).
+    //
+    //  -   publish.     0,  -  -1.
+    //
+    //     BroadcastRing<Tick> ring(1 << 16);
+    //     int journal = ring.subscribe();
+    //     int trader = ring.subscribe({ journal });        //    journal
+    //     ...
+    //     ring.publish(tick);                               // 
+    //     ring.poll(trader, [](const Tick& tick) { ... });  //   trader
+    */
+private:
+    struct alignas(128) Subscriber {
+        std::atomic<int64_t> sequence{ -1 };   //   
+        std::vector<int> dependencies;          //     publish
+    };
+
+    static const int MAX_SUBSCRIBERS = 64;
+
+    const int64_t capacity;
+    const int64_t mask;
+    std::unique_ptr<T[]> entries;
+
+    alignas(128) std::atomic<int64_t> cursor{ -1 };    //   
+    int64_t next = 0;                                   //  
+    int64_t cachedGate = -1;                            //  :    
+    bool started = false;                               //  
+
+    Subscriber subscribers[MAX_SUBSCRIBERS];
+    int subscriberCount = 0;
+
+    static int64_t roundUp(int64_t size) {
+        int64_t count = 2;
+        while (count < size) count *= 2;
+        return count;
+    }
+
+    int64_t slowestSequence() const {
+        int64_t slowest = cursor.load(std::memory_order_relaxed);
+        for (int i = 0; i < subscriberCount; i++) {
+            int64_t sequence = subscribers[i].sequence.load(std::memory_order_acquire);
+            if (sequence < slowest) slowest = sequence;
+        }
+        return slowest;
+    }
+
+    //      next
+    bool hasSpace() {
+        if (next - capacity <= cachedGate) return true;
+        cachedGate = slowestSequence();
+        return next - capacity <= cachedGate;
+    }
+
+public:
+    // capacity     
+    BroadcastRing(int64_t capacity = 1 << 16) : capacity{ roundUp(capacity) }, mask{ roundUp(capacity) - 1 },
+        entries{ new T[roundUp(capacity)] } { }
+
+    BroadcastRing(const BroadcastRing&) = delete;
+    BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+    //  ,     dependencies.   .
+    int subscribe(const std::vector<int>& dependencies = {}) {
+        if (started) throw std::logic_error("subscribe after publish");
+        if (subscriberCount == MAX_SUBSCRIBERS) throw std::length_error("too many subscribers");
+        for (int dependency : dependencies)
+            if (dependency < 0 || dependency >= subscriberCount) throw std::invalid_argument("unknown dependency");
+        subscribers[subscriberCount].dependencies = dependencies;
+        return subscriberCount++;
+    }
+
+    //    ( ). false -      capacity.
+    bool tryPublish(const T& value) {
+        started = true;
+        if (!hasSpace()) return false;
+        entries[next & mask] = value;
+        cursor.store(next, std::memory_order_release);
+        next++;
+        return true;
+    }
+
+    //    :   ,    
+    void publish(const T& value) {
+        for (unsigned spin = 0; !tryPublish(value); spin++)
+            if (spin >= 64) std::this_thread::yield();
+    }
+
+    //   max    subscriber: handler(const T&)  .
+    //      .    .
+    template<typename F>
+    size_t poll(int subscriber, F&& handler, size_t max = SIZE_MAX) {
+        Subscriber& self = subscribers[subscriber];
+        int64_t sequence = self.sequence.load(std::memory_order_relaxed);
+        int64_t available = cursor.load(std::memory_order_acquire);
+        for (int dependency : self.dependencies) {
+            int64_t done = subscribers[dependency].sequence.load(std::memory_order_acquire);
+            if (done < available) available = done;
+        }
+        if (available <= sequence) return 0;
+        if ((uint64_t)(available - sequence) > max) available = sequence + (int64_t)max;
+        for (int64_t i = sequence + 1; i <= available; i++)
+            handler((const T&)entries[i & mask]);
+        self.sequence.store(available, std::memory_order_release);
+        return (size_t)(available - sequence);
+    }
+
+    //    subscriber   
+    int64_t getLag(int subscriber) const {
+        return cursor.load() - subscribers[subscriber].sequence.load();
+    }
+
+    int64_t getCapacity() const {
+        return capacity;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,163 @@
+#ifndef _BYTE_RING_H_
+#define _BYTE_RING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+
+class ByteRing {
+    /*
+    //              .
+    //   ( , singleProducer)   .
+    //
+    //    : reserve   ,     ,
+    // commit  .   : peek     , release
+    //   .
+    //
+    //  -   8  (  )  ,   8 .   
+    //    ,   -,      .
+    //    tail  CAS.       
+    //  ,    :   -    .
+    //     : ,    
+    //  ,     commit.
+    //
+    //     void* span = ring.reserve(size);     // nullptr -  
+    //     memcpy(span, data, size);
+    //     ring.commit(span);
+    //     ...
+    //     uint64_t size;
+    //     while (const void* message = ring.peek(size)) {
+    //         handle(message, size);
+    //         ring.release();
+    //     }
+    */
+private:
+    struct Header {
+        std::atomic<uint32_t> state;    // EMPTY  commit
+        uint32_t length;                //      
+    };
+
+    static const uint32_t EMPTY = 0;
+    static const uint32_t COMMITTED = 1;
+    static const uint32_t PADDING = 2;
+    static const uint64_t HEADER = sizeof(Header);
+
+    const uint64_t capacity;
+    const uint64_t mask;
+    const bool singleProducer;
+    std::unique_ptr<uint64_t[]> storage;
+    char* const buffer;
+
+    alignas(128) std::atomic<uint64_t> tail{ 0 };   //   
+    alignas(128) std::atomic<uint64_t> head{ 0 };   //    
+
+    static uint64_t roundUp(uint64_t size) {
+        uint64_t count = 64;
+        while (count < size) count *= 2;
+        return count;
+    }
+
+    static uint64_t align(uint64_t size) {
+        return (size + 7) & ~(uint64_t)7;
+    }
+
+    Header* at(uint64_t position) const {
+        return (Header*)(buffer + (position & mask));
+    }
+
+public:
+    // capacity     ,   64 
+    ByteRing(uint64_t capacity = 1 << 20, bool singleProducer = false) : capacity{ roundUp(capacity) }, mask{ roundUp(capacity) - 1 },
+        singleProducer{ singleProducer }, storage{ new uint64_t[roundUp(capacity) / 8]() }, buffer{ (char*)storage.get() } { }
+
+    ByteRing(const ByteRing&) = delete;
+    ByteRing& operator=(const ByteRing&) = delete;
+
+    //   :           tail
+    uint64_t getMaxMessage() const {
+        return capacity / 2 - HEADER;
+    }
+
+    uint64_t getCapacity() const {
+        return capacity;
+    }
+
+    //  size . nullptr -   .
+    void* reserve(uint64_t size) {
+        if (size > getMaxMessage()) throw std::invalid_argument("message is larger than getMaxMessage()");
+        const uint64_t need = align(HEADER + size);
+        uint64_t position = tail.load(std::memory_order_relaxed);
+        uint64_t total;
+        while (true) {
+            uint64_t contiguous = capacity - (position & mask);
+            total = need <= contiguous ? need : contiguous + need;
+            if (position + total - head.load(std::memory_order_acquire) > capacity) return nullptr;
+            if (singleProducer) {
+                tail.store(position + total, std::memory_order_relaxed);
+                break;
+            }
+            if (tail.compare_exchange_weak(position, position + total)) break;
+        }
+        if (total != need) {
+            Header* padding = at(position);
+            padding->length = (uint32_t)(total - need - HEADER);
+            padding->state.store(PADDING, std::memory_order_release);
+            position += total - need;
+        }
+        Header* header = at(position);
+        header->length = (uint32_t)size;
+        return header + 1;
+    }
+
+    //  ,   reserve
+    void commit(void* span) {
+        ((Header*)span - 1)->state.store(COMMITTED, std::memory_order_release);
+    }
+
+    //    . false -   .
+    bool write(const void* data, uint64_t size) {
+        void* span = reserve(size);
+        if (span == nullptr) return false;
+        memcpy(span, data, size);
+        commit(span);
+        return true;
+    }
+
+    //    ( ). nullptr -  .
+    //    release.
+    const void* peek(uint64_t& size) {
+        while (true) {
+            uint64_t position = head.load(std::memory_order_relaxed);
+            Header* header = at(position);
+            uint32_t state = header->state.load(std::memory_order_acquire);
+            if (state == EMPTY) return nullptr;
+            if (state == COMMITTED) {
+                size = header->length;
+                return header + 1;
+            }
+            //    
+            uint64_t span = HEADER + header->length;
+            memset((void*)header, 0, span);
+            head.store(position + span, std::memory_order_release);
+        }
+    }
+
+    //  ,   peek ( )
+    void release() {
+        uint64_t position = head.load(std::memory_order_relaxed);
+        Header* header = at(position);
+        if (header->state.load(std::memory_order_relaxed) != COMMITTED) throw std::logic_error("release without peek");
+        uint64_t span = align(HEADER + header->length);
+        memset((void*)header, 0, span);
+        head.store(position + span, std::memory_order_release);
+    }
+
+    bool isEmpty() const {
+        return at(head.load())->state.load() == EMPTY;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef _CACHE_ALIGNED_H_
+#define _CACHE_ALIGNED_H_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+
+struct CacheAligned {
+    /*
+    //       alignas(128).  C++17 new   
+    //  alignof(std::max_align_t),   ,   new  new[],
+    //      .   operator new/delete,
+    //     ALIGNMENT.
+    */
+    static const size_t ALIGNMENT = 128;
+
+    static void* allocate(size_t size) {
+        if (size == 0) size = 1;
+#ifdef _WIN32
+        void* memory = _aligned_malloc(size, ALIGNMENT);
+        if (memory == nullptr) throw std::bad_alloc();
+#else
+        void* memory = nullptr;
+        if (posix_memalign(&memory, ALIGNMENT, size) != 0) throw std::bad_alloc();
+#endif
+        return memory;
+    }
+
+    static void deallocate(void* memory) {
+#ifdef _WIN32
+        _aligned_free(memory);
+#else
+        free(memory);
+#endif
+    }
+
+    static void* operator new(size_t size) { return allocate(size); }
+    static void* operator new[](size_t size) { return allocate(size); }
+    static void operator delete(void* memory) { deallocate(memory); }
+    static void operator delete[](void* memory) { deallocate(memory); }
+};
+
+#endif
\ No newline at end of file
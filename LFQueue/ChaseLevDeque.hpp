@@ -0,0 +1,135 @@
+#ifndef _CHASE_LEV_DEQUE_H_
+#define _CHASE_LEV_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include "HazardPointers.hpp"
+#include "CacheAligned.hpp"
+
+
+template<typename T>
+class ChaseLevDeque : public CacheAligned {
+    /*
+    //     Chase-Lev (),    Le, Pop, Cohen, Nardelli (2013).
+    //         (LIFO)   RMW-,  
+    //   ;       (FIFO)  CAS  top.
+    //          ,   
+    //   HazardPointers: ,     ,    Hazard Pointer.
+    //
+    // push  pop   -, steal -  ,    .
+    */
+private:
+    struct Buffer {
+        const int64_t capacity;             //  
+        std::atomic<T*>* slots;
+
+        Buffer(int64_t capacity) : capacity{ capacity }, slots{ new std::atomic<T*>[capacity] } { }
+
+        ~Buffer() {
+            delete[] slots;
+        }
+
+        T* get(int64_t index) const {
+            return slots[index & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T* item) {
+            slots[index & (capacity - 1)].store(item, std::memory_order_relaxed);
+        }
+    };
+
+    const int kHpBuffer = 0;
+
+    alignas(128) std::atomic<int64_t> top{ 0 };
+    alignas(128) std::atomic<int64_t> bottom{ 0 };
+    alignas(128) std::atomic<Buffer*> buffer;
+
+    HazardPointers<Buffer> hp;
+
+    //   ;  
+    Buffer* grow(Buffer* old, int64_t t, int64_t b, const int tid) {
+        Buffer* larger = new Buffer(old->capacity * 2);
+        for (int64_t i = t; i < b; i++)
+            larger->put(i, old->get(i));
+        buffer.store(larger, std::memory_order_release);
+        hp.retire(old, tid);
+        return larger;
+    }
+
+public:
+    // capacity -   ,     
+    ChaseLevDeque(int maxThreads = 128, int64_t capacity = 64) : hp{ 1, maxThreads } {
+        if (capacity <= 0) throw std::invalid_argument("capacity must be positive");
+        int64_t size = 1;
+        while (size < capacity) size *= 2;
+        buffer.store(new Buffer(size), std::memory_order_relaxed);
+    }
+
+    ~ChaseLevDeque() {
+        delete buffer.load();
+    }
+
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    //      ( )
+    void push(T* item, const int tid) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1)
+            a = grow(a, t, b, tid);
+        a->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    //      ( ). nullptr -  .
+    T* pop(const int /*tid*/) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* a = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        T* item = nullptr;
+        if (t <= b) {
+            item = a->get(b);
+            if (t == b) {
+                //  :   
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    item = nullptr;
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+        }
+        else bottom.store(b + 1, std::memory_order_relaxed);
+        return item;
+    }
+
+    //     . nullptr -       .
+    T* steal(const int tid) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return nullptr;
+        Buffer* a = hp.protect(kHpBuffer, buffer, tid);
+        T* item = a->get(t);
+        bool stolen = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        hp.clearOne(kHpBuffer, tid);
+        return stolen ? item : nullptr;
+    }
+
+    //   ()
+    int64_t size() const {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+    bool isEmpty() const {
+        return size() == 0;
+    }
+};
+
+#endif
\ No newline at end of file
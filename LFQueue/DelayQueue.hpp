@@ -0,0 +1,198 @@
+#ifndef _DELAY_QUEUE_H_
+#define _DELAY_QUEUE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include "MSQueue.hpp"
+
+
+template<typename T>
+class DelayQueue {
+    /*
+    //    :     pop    .
+    //     : LEVELS   SLOTS ,   L
+    //  SLOTS^L .         overflow.
+    //       MSQueue,     pop.
+    //
+    //  -   : push   CAS-  O(1),   
+    //    exchange,  ABA  Hazard Pointers   .  current -
+    //   .       (    advancing):
+    //   current,    ,    -  
+    //     .    ,  push    , push
+    //   ,    .
+    //
+    //     ,      ,   
+    //        pop ( advance).    pop -    
+    //   .       .
+    // ,     , ,   -  (  MSQueue).
+    */
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Entry {
+        T* item;
+        int64_t due;            // ,      
+        Entry* next;
+
+        Entry(T* userItem, int64_t dueTick) : item{ userItem }, due{ dueTick }, next{ nullptr } { }
+    };
+
+    static const int MAX_THREADS = 128;
+    static const int BITS = 6;
+    static const int SLOTS = 1 << BITS;                 //   
+    static const int64_t SLOT_MASK = SLOTS - 1;
+    static const int LEVELS = 4;                        // 2^24 :   1  -  4.6 
+
+    const Clock::time_point origin;
+    const Clock::duration tick;
+
+    std::atomic<Entry*> wheel[LEVELS][SLOTS];
+    std::atomic<Entry*> overflow{ nullptr };
+
+    alignas(128) std::atomic<int64_t> current{ 0 };
+    alignas(128) std::atomic<bool> advancing{ false };
+
+    MSQueue<T> ready;
+
+    // ,    time;    -  
+    int64_t tickOf(Clock::time_point time, bool roundUp) const {
+        Clock::duration elapsed = time - origin;
+        if (elapsed.count() <= 0) return 0;
+        int64_t ticks = elapsed / tick;
+        if (roundUp && elapsed % tick != Clock::duration::zero()) ticks++;
+        return ticks;
+    }
+
+    // CAS     drain - seq_cst,      : push (  , 
+    //  current)  advance ( current,   )       
+    static void pushSlot(std::atomic<Entry*>& slot, Entry* entry) {
+        Entry* top = slot.load(std::memory_order_relaxed);
+        do {
+            entry->next = top;
+        } while (!slot.compare_exchange_weak(top, entry, std::memory_order_seq_cst, std::memory_order_relaxed));
+    }
+
+    //    :       
+    void place(Entry* entry, const int tid) {
+        int64_t cursor = current.load();
+        if (entry->due < cursor) {
+            ready.push(entry->item, tid);
+            delete entry;
+            return;
+        }
+        //  -   ,      
+        int64_t difference = entry->due ^ cursor;
+        int level = 0;
+        while (level < LEVELS && (difference >> (BITS * (level + 1))) != 0) level++;
+
+        std::atomic<Entry*>* slot;
+        int64_t drainTick;      // ,     
+        if (level == LEVELS) {
+            slot = &overflow;
+            drainTick = ((cursor >> (BITS * LEVELS)) + 1) << (BITS * LEVELS);
+        }
+        else {
+            slot = &wheel[level][(entry->due >> (BITS * level)) & SLOT_MASK];
+            drainTick = (entry->due >> (BITS * level)) << (BITS * level);
+        }
+        pushSlot(*slot, entry);
+        //     :      drainTick,   
+        if (current.load() > drainTick) drain(*slot, tid);
+    }
+
+    //   :      
+    void drain(std::atomic<Entry*>& slot, const int tid) {
+        if (slot.load() == nullptr) return;
+        Entry* entry = slot.exchange(nullptr, std::memory_order_acquire);
+        Entry* reversed = nullptr;
+        while (entry != nullptr) {
+            Entry* next = entry->next;
+            entry->next = reversed;
+            reversed = entry;
+            entry = next;
+        }
+        while (reversed != nullptr) {
+            Entry* next = reversed->next;
+            place(reversed, tid);
+            reversed = next;
+        }
+    }
+
+    static void deleteSlot(std::atomic<Entry*>& slot) {
+        Entry* entry = slot.load();
+        while (entry != nullptr) {
+            Entry* next = entry->next;
+            delete entry;
+            entry = next;
+        }
+    }
+
+public:
+    // tick -   ( )
+    DelayQueue(Clock::duration tick = std::chrono::milliseconds(1), int maxThreads = MAX_THREADS) :
+        origin{ Clock::now() }, tick{ tick }, ready(maxThreads) {
+        if (tick <= Clock::duration::zero()) throw std::invalid_argument("tick must be positive");
+        for (int level = 0; level < LEVELS; level++)
+            for (int slot = 0; slot < SLOTS; slot++)
+                wheel[level][slot].store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~DelayQueue() {
+        for (int level = 0; level < LEVELS; level++)
+            for (int slot = 0; slot < SLOTS; slot++)
+                deleteSlot(wheel[level][slot]);
+        deleteSlot(overflow);
+    }
+
+    DelayQueue(const DelayQueue&) = delete;
+    DelayQueue& operator=(const DelayQueue&) = delete;
+
+    //  ,      due
+    void push(T* item, Clock::time_point due, const int tid) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        place(new Entry(item, tickOf(due, true)), tid);
+    }
+
+    //  ,     delay
+    template<typename Rep, typename Period>
+    void pushAfter(T* item, std::chrono::duration<Rep, Period> delay, const int tid) {
+        push(item, Clock::now() + std::chrono::duration_cast<Clock::duration>(delay), tid);
+    }
+
+    //      .   pop;    
+    //  ,      pop.     ,  .
+    void advance(const int tid) {
+        int64_t now = tickOf(Clock::now(), false);
+        if (current.load(std::memory_order_acquire) > now) return;
+        if (advancing.exchange(true, std::memory_order_acquire)) return;
+        for (int64_t t = current.load(); t <= now; t++) {
+            current.store(t + 1);
+            //   ,      ,    
+            if ((t & ((int64_t(1) << (BITS * LEVELS)) - 1)) == 0) drain(overflow, tid);
+            for (int level = LEVELS - 1; level > 0; level--)
+                if ((t & ((int64_t(1) << (BITS * level)) - 1)) == 0)
+                    drain(wheel[level][(t >> (BITS * level)) & SLOT_MASK], tid);
+            drain(wheel[0][t & SLOT_MASK], tid);
+        }
+        advancing.store(false, std::memory_order_release);
+    }
+
+    //   , nullptr -  
+    T* pop(const int tid) {
+        advance(tid);
+        return ready.pop(tid);
+    }
+
+    //       (  ,     )
+    bool isReady() {
+        return !ready.isEmpty();
+    }
+
+    Clock::duration getTick() const {
+        return tick;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,233 @@
+#ifndef _DUAL_QUEUE_H_
+#define _DUAL_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include "CacheAligned.hpp"
+#include "EventCount.hpp"
+#include "HazardPointers.hpp"
+
+
+template<typename T>
+class DualQueue {
+    /*
+    //   (dual queue, Scherer  Scott)    -:   
+    //  ,   ,      .    .
+    //
+    // take,   ,         . push,    ,
+    //   ,            . 
+    //    ,      :    
+    //      .
+    //
+    // :  ,    ,    EventCount.   
+    //  EventCount (     ),      
+    // ,   , -     .   ,
+    //   take      .  ,    MSQueue,
+    //  .
+    */
+private:
+    struct Node {
+        std::atomic<T*> item;           // ;   - nullptr  
+        std::atomic<Node*> next;
+        std::atomic<bool> parked;       //      notify
+        const bool isRequest;
+        const int owner;                // tid  
+
+        Node(T* userItem, bool request, int owner = 0)
+            : item{ userItem }, next{ nullptr }, parked{ false }, isRequest{ request }, owner{ owner } { }
+
+        bool casNext(Node* cmp, Node* val) {
+            return next.compare_exchange_strong(cmp, val);
+        }
+    };
+
+    bool casTail(Node* cmp, Node* val) {
+        return tail.compare_exchange_strong(cmp, val);
+    }
+
+    bool casHead(Node* cmp, Node* val) {
+        return head.compare_exchange_strong(cmp, val);
+    }
+
+    alignas(128) std::atomic<Node*> head;
+    alignas(128) std::atomic<Node*> tail;
+
+    static const int MAX_THREADS = 128;
+    static const unsigned SPINS = 64;           //   
+    static const unsigned YIELDS = 64;          //      
+    const int maxThreads;
+
+    HazardPointers<Node> hp{ 4, maxThreads };
+    const int kHpTail = 0;
+    const int kHpHead = 1;
+    const int kHpNext = 2;
+    const int kHpOwn = 3;       //     
+
+    //   ;    
+    struct Parking : CacheAligned {
+        EventCount event;
+    };
+
+    std::unique_ptr<Parking[]> parking;
+
+    //    
+    T* await(Node* request) {
+        EventCount& waiters = parking[request->owner].event;
+        T* item;
+        for (unsigned spin = 0; spin < SPINS + YIELDS; spin++) {
+            if ((item = request->item.load(std::memory_order_acquire)) != nullptr) return item;
+            if (spin >= SPINS) std::this_thread::yield();
+        }
+        while (true) {
+            uint64_t key = waiters.prepareWait();
+            // parked    , push     parked:
+            //       
+            request->parked.store(true);
+            if ((item = request->item.load()) != nullptr) {
+                waiters.cancelWait();
+                return item;
+            }
+            waiters.wait(key);
+            if ((item = request->item.load()) != nullptr) return item;
+        }
+    }
+
+    //     . false -  ,  .
+    bool takeData(Node* ltail, Node* lhead, T*& item, const int tid) {
+        Node* lnext = hp.protect(kHpNext, lhead->next, tid);
+        //      
+        if (lhead != head.load() || ltail != tail.load() || lnext == nullptr || lhead == tail.load()) return false;
+        //     ;        ,   
+        if (lnext->isRequest) return false;
+        if (!casHead(lhead, lnext)) return false;
+        item = lnext->item.load();
+        hp.clear(tid);
+        hp.retire(lhead, tid);
+        return true;
+    }
+
+public:
+    DualQueue(int maxThreads = MAX_THREADS) : maxThreads{ maxThreads }, parking{ new Parking[maxThreads] } {
+        Node* sentinelNode = new Node(nullptr, false);
+        head.store(sentinelNode, std::memory_order_relaxed);
+        tail.store(sentinelNode, std::memory_order_relaxed);
+    }
+
+    ~DualQueue() {
+        Node* node = head.load();
+        while (node != nullptr) {
+            Node* next = node->next.load();
+            delete node;
+            node = next;
+        }
+    }
+
+    DualQueue(const DualQueue&) = delete;
+    DualQueue& operator=(const DualQueue&) = delete;
+
+    //  :       
+    bool isEmpty(const int tid) {
+        Node* ltail = hp.protect(kHpTail, tail, tid);
+        bool empty = ltail == head.load() || ltail->isRequest;
+        hp.clear(tid);
+        return empty;
+    }
+
+    //         ,   
+    void push(T* item, const int tid) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        Node* node = nullptr;
+        while (true) {
+            Node* ltail = hp.protect(kHpTail, tail, tid);
+            Node* lhead = hp.protect(kHpHead, head, tid);
+            if (ltail == lhead || !ltail->isRequest) {
+                //     :  ,   MSQueue
+                Node* lnext = ltail->next.load();
+                if (ltail != tail.load()) continue;
+                if (lnext != nullptr) {
+                    casTail(ltail, lnext);
+                    continue;
+                }
+                if (node == nullptr) node = new Node(item, false);
+                if (ltail->casNext(nullptr, node)) {
+                    casTail(ltail, node);
+                    hp.clear(tid);
+                    return;
+                }
+            }
+            else {
+                //   :       ,    
+                Node* lnext = hp.protect(kHpNext, lhead->next, tid);
+                if (lhead != head.load() || ltail != tail.load() || lnext == nullptr || lhead == tail.load()) continue;
+                //        :     
+                if (!lnext->isRequest) continue;
+                T* expected = nullptr;
+                bool fulfilled = lnext->item.compare_exchange_strong(expected, item);
+                if (casHead(lhead, lnext)) {
+                    hp.clearOne(kHpHead, tid);
+                    hp.retire(lhead, tid);
+                }
+                if (fulfilled) {
+                    if (lnext->parked.load()) parking[lnext->owner].event.notifyOne();
+                    hp.clear(tid);
+                    delete node;        //    ,     
+                    return;
+                }
+            }
+        }
+    }
+
+    //   , nullptr -  
+    T* tryPop(const int tid) {
+        T* item;
+        while (true) {
+            Node* ltail = hp.protect(kHpTail, tail, tid);
+            Node* lhead = hp.protect(kHpHead, head, tid);
+            if (ltail == lhead || ltail->isRequest) {
+                hp.clear(tid);
+                return nullptr;
+            }
+            if (takeData(ltail, lhead, item, tid)) return item;
+        }
+    }
+
+    //   :      ,    push
+    T* take(const int tid) {
+        Node* request = nullptr;
+        T* item;
+        while (true) {
+            Node* ltail = hp.protect(kHpTail, tail, tid);
+            Node* lhead = hp.protect(kHpHead, head, tid);
+            if (ltail == lhead || ltail->isRequest) {
+                //     :  
+                Node* lnext = ltail->next.load();
+                if (ltail != tail.load()) continue;
+                if (lnext != nullptr) {
+                    casTail(ltail, lnext);
+                    continue;
+                }
+                if (request == nullptr) {
+                    request = new Node(nullptr, true, tid);
+                    hp.protectPtr(kHpOwn, request, tid);
+                }
+                if (ltail->casNext(nullptr, request)) {
+                    casTail(ltail, request);
+                    hp.clearOne(kHpTail, tid);
+                    hp.clearOne(kHpHead, tid);
+                    item = await(request);
+                    hp.clear(tid);
+                    return item;
+                }
+            }
+            else if (takeData(ltail, lhead, item, tid)) {
+                delete request;         //     
+                return item;
+            }
+        }
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef _EVENT_COUNT_H_
+#define _EVENT_COUNT_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+
+class EventCount {
+    /*
+    //          .
+    // :                                  :
+    //     key = ec.prepareWait();                     queue.push(...);
+    //     if ( ) ec.cancelWait();     ec.notifyOne();
+    //     else ec.wait(key);
+    //  -  64- :  32  - ,  -  .
+    //   , notify    .
+    */
+private:
+    static const uint64_t WAITER = 1;
+    static const uint64_t EPOCH = uint64_t(1) << 32;
+    static const uint64_t WAITERS_MASK = EPOCH - 1;
+
+    alignas(128) std::atomic<uint64_t> state{ 0 };
+    std::mutex lock;
+    std::condition_variable cv;
+
+    void notify(bool all) {
+        if ((state.load() & WAITERS_MASK) == 0) return;
+        std::lock_guard<std::mutex> guard(lock);
+        state.fetch_add(EPOCH);
+        if (all) cv.notify_all();
+        else cv.notify_one();
+    }
+
+public:
+    //    .    .
+    uint64_t prepareWait() {
+        return state.fetch_add(WAITER) >> 32;
+    }
+
+    //     prepareWait
+    void cancelWait() {
+        state.fetch_sub(WAITER);
+    }
+
+    // ,      prepareWait
+    void wait(uint64_t key) {
+        std::unique_lock<std::mutex> guard(lock);
+        while ((state.load() >> 32) == key)
+            cv.wait(guard);
+        state.fetch_sub(WAITER);
+    }
+
+    void notifyOne() {
+        notify(false);
+    }
+
+    void notifyAll() {
+        notify(true);
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef _EVENTFD_NOTIFIER_H_
+#define _EVENTFD_NOTIFIER_H_
+
+//  Linux: eventfd(2)
+#ifdef __linux__
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "MSQueue.hpp"
+#include "QueueNotifier.hpp"
+
+
+class EventFdNotifier : public QueueNotifier {
+    /*
+    //   eventfd  ,   epoll_wait.
+    //          :  armed  ,
+    //   ,    push  .  push 
+    //   armed,   .
+    //
+    //     EventFdNotifier notifier;
+    //     queue.setNotifier(&notifier);
+    //     epoll_ctl(ep, EPOLL_CTL_ADD, notifier.getFd(), &event);     // EPOLLIN
+    //     ...
+    //     // fd   :
+    //     notifier.drain(queue, tid, [](T* item) { ... });
+    //
+    //  MSQueue     (setNotifier),  ,   QueueSelector,
+    //      EventFdNotifier:  setNotifier  .
+    */
+private:
+    int fd;
+    alignas(128) std::atomic<bool> armed{ true };   //   
+
+    void signal() {
+        uint64_t one = 1;
+        while (write(fd, &one, sizeof(one)) < 0 && errno == EINTR);
+    }
+
+public:
+    EventFdNotifier() {
+        fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "eventfd");
+    }
+
+    ~EventFdNotifier() {
+        close(fd);
+    }
+
+    EventFdNotifier(const EventFdNotifier&) = delete;
+    EventFdNotifier& operator=(const EventFdNotifier&) = delete;
+
+    //   epoll (EPOLLIN)
+    int getFd() const {
+        return fd;
+    }
+
+    void notify() override {
+        if (!armed.load()) return;          //     
+        if (armed.exchange(false)) signal();
+    }
+
+    //   eventfd  
+    void consume() {
+        uint64_t value;
+        while (read(fd, &value, sizeof(value)) < 0 && errno == EINTR);
+    }
+
+    //  .        :
+    // ,   ,   .
+    void arm() {
+        armed.store(true);
+    }
+
+    //  :  eventfd    maxBatch ,    handler.
+    //   ,   .   maxBatch, eventfd   ,
+    //          .
+    //    .
+    template<typename T, typename Handler>
+    size_t drain(MSQueue<T>& queue, const int tid, Handler handler, size_t maxBatch = SIZE_MAX) {
+        consume();
+        size_t count = 0;
+        while (true) {
+            T* item;
+            while (count < maxBatch && (item = queue.pop(tid)) != nullptr) {
+                handler(item);
+                count++;
+            }
+            if (count >= maxBatch) {
+                signal();
+                return count;
+            }
+            arm();
+            if (queue.isEmpty()) return count;
+            //     pop  arm;  push    
+        }
+    }
+};
+
+#endif
+
+#endif
\ No newline at end of file
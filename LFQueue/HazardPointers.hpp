@@ -21,8 +21,27 @@ private:
 
     // Hazard Pointers
     std::atomic<T*>* hp[HP_MAX_THREADS];
-    // .     .      .
-    std::vector<T*> retiredList[HP_MAX_THREADS * CLPAD];
+    //       ,      .
+    //   128 ,          .
+    struct RetiredList {
+        std::vector<T*> list;
+        std::atomic<size_t> count;
+        char pad[128 - sizeof(std::vector<T*>) - sizeof(std::atomic<size_t>)];
+    };
+    RetiredList retired[HP_MAX_THREADS];
+
+public:
+    //    delete,     . tid - ,  retire.
+    typedef void (*Deleter)(T* ptr, void* context, const int tid);
+
+private:
+    Deleter deleter = nullptr;
+    void* deleterContext = nullptr;
+
+    void release(T* ptr, const int tid) {
+        if (deleter != nullptr) deleter(ptr, deleterContext, tid);
+        else delete ptr;
+    }
 
 public:
     // 
@@ -33,6 +52,7 @@ public:
             hp[iptr] = new std::atomic<T*>[CLPAD * 2]; 
             for (int ihp = 0; ihp < HP_MAX_HPS; ihp++)
                 hp[iptr][ihp].store(nullptr, std::memory_order_relaxed);
+            retired[iptr].count.store(0, std::memory_order_relaxed);
         }
     }
 
@@ -40,11 +60,24 @@ public:
         for (int iptr = 0; iptr < HP_MAX_THREADS; iptr++) {
             delete[] hp[iptr];
             //   
-            for (unsigned iret = 0; iret < retiredList[iptr * CLPAD].size(); iret++)
-                delete retiredList[iptr * CLPAD][iret];
+            for (unsigned iret = 0; iret < retired[iptr].list.size(); iret++)
+                release(retired[iptr].list[iret], 0);
         }
     }
 
+    //    delete (nullptr -  delete).      .
+    void setDeleter(Deleter newDeleter, void* context) {
+        deleter = newDeleter;
+        deleterContext = context;
+    }
+
+    //       ,  retire   .
+    //         -   maxThreads * maxHPs.
+    void reserveRetired() {
+        for (int tid = 0; tid < maxThreads; tid++)
+            retired[tid].list.reserve((size_t)maxThreads * maxHPs + 1);
+    }
+
     //     tid
     void clear(const int tid) {
         for (int ihp = 0; ihp < maxHPs; ihp++)
@@ -81,12 +114,14 @@ public:
 
     //    retiredList   tid
     void retire(T* ptr, const int tid) {
-        retiredList[tid * CLPAD].push_back(ptr);
+        std::vector<T*>& retiredList = retired[tid].list;
+        retiredList.push_back(ptr);
+        retired[tid].count.store(retiredList.size(), std::memory_order_relaxed);
 
-        if (retiredList[tid * CLPAD].size() < HP_THRESHOLD_R) return;
+        if (retiredList.size() < HP_THRESHOLD_R) return;
         
-        for (unsigned iret = 0; iret < retiredList[tid * CLPAD].size(); ) {
-            auto obj = retiredList[tid * CLPAD][iret];
+        for (unsigned iret = 0; iret < retiredList.size(); ) {
+            auto obj = retiredList[iret];
             bool canDelete = true;
             for (int tid = 0; tid < maxThreads && canDelete; tid++)
                 for (int ihp = maxHPs - 1; ihp >= 0; ihp--)
@@ -95,12 +130,26 @@ public:
                         break;
                     }
             if (canDelete) {
-                retiredList[tid * CLPAD].erase(retiredList[tid * CLPAD].begin() + iret);
-                delete obj;
+                retiredList.erase(retiredList.begin() + iret);
+                release(obj, tid);
                 continue;
             }
             iret++;
         }
+        retired[tid].count.store(retiredList.size(), std::memory_order_relaxed);
+    }
+
+    //  ,         ()
+    size_t getRetiredCount() const {
+        size_t count = 0;
+        for (int tid = 0; tid < HP_MAX_THREADS; tid++)
+            count += retired[tid].count.load(std::memory_order_relaxed);
+        return count;
+    }
+
+    //  ,     (  retiredList)
+    static size_t getHeapBytes() {
+        return HP_MAX_THREADS * CLPAD * 2 * sizeof(std::atomic<T*>);
     }
 };
 
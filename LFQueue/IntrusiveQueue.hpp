@@ -0,0 +1,122 @@
+#ifndef _INTRUSIVE_QUEUE_H_
+#define _INTRUSIVE_QUEUE_H_
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include "HazardPointers.hpp"
+
+
+//   ;     
+struct IntrusiveHook {
+    std::atomic<IntrusiveHook*> next{ nullptr };
+};
+
+
+template<typename T, typename Disposer = std::default_delete<T>>
+class IntrusiveQueue {
+    /*
+    //    -:     (T   IntrusiveHook),
+    //  push  pop   .    -    (stub).
+    //
+    //  .    MSQueue, pop     ,    
+    //   ,   pop    .    
+    //      :    Disposer,    
+    //            Hazard Pointer. ,  ,
+    //    Hazard Pointer    pop  release(tid) -    
+    //   ;    ,   .
+    //   Disposer    delete;         .
+    //   Disposer  .    Disposer   .
+    */
+    static_assert(std::is_base_of<IntrusiveHook, T>::value, "T must derive from IntrusiveHook");
+
+private:
+    alignas(128) std::atomic<IntrusiveHook*> head;
+    alignas(128) std::atomic<IntrusiveHook*> tail;
+
+    IntrusiveHook stub;
+    Disposer disposer;
+
+    static const int MAX_THREADS = 128;
+    const int maxThreads;
+
+    HazardPointers<IntrusiveHook> hp{ 2, maxThreads };
+    const int kHpTail = 0;
+    const int kHpHead = 0;
+    const int kHpNext = 1;
+
+    static void dispose(IntrusiveHook* hook, void* context, const int /*tid*/) {
+        IntrusiveQueue* queue = (IntrusiveQueue*)context;
+        if (hook != &queue->stub) queue->disposer(static_cast<T*>(hook));
+    }
+
+public:
+    IntrusiveQueue(int maxThreads = MAX_THREADS, Disposer disposer = Disposer()) : disposer(disposer), maxThreads{ maxThreads } {
+        head.store(&stub, std::memory_order_relaxed);
+        tail.store(&stub, std::memory_order_relaxed);
+        hp.setDeleter(&IntrusiveQueue::dispose, this);
+    }
+
+    ~IntrusiveQueue() {
+        T* item;
+        while ((item = pop(0)) != nullptr);
+        dispose(head.load(), this, 0);
+    }
+
+    IntrusiveQueue(const IntrusiveQueue&) = delete;
+    IntrusiveQueue& operator=(const IntrusiveQueue&) = delete;
+
+    bool isEmpty() {
+        return head.load() == tail.load();
+    }
+
+    void push(T* item, const int tid) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        IntrusiveHook* node = item;
+        node->next.store(nullptr, std::memory_order_relaxed);
+        while (true) {
+            IntrusiveHook* ltail = hp.protect(kHpTail, tail, tid);
+            IntrusiveHook* lnext = ltail->next.load();
+            if (ltail != tail.load()) continue;
+            if (lnext != nullptr) {
+                tail.compare_exchange_strong(ltail, lnext);
+                continue;
+            }
+            if (ltail->next.compare_exchange_strong(lnext, node)) {
+                tail.compare_exchange_strong(ltail, node);
+                hp.clearOne(kHpTail, tid);     // kHpNext   ,   
+                return;
+            }
+        }
+    }
+
+    //  , nullptr -  .     pop  tid
+    //  release(tid),     Disposer.
+    T* pop(const int tid) {
+        IntrusiveHook* node = hp.protect(kHpHead, head, tid);
+        while (node != tail.load()) {
+            IntrusiveHook* lnext = hp.protect(kHpNext, node->next, tid);
+            if (lnext != nullptr && head.compare_exchange_strong(node, lnext)) {
+                hp.clearOne(kHpHead, tid);
+                hp.retire(node, tid);
+                return static_cast<T*>(lnext);
+            }
+            node = hp.protect(kHpHead, head, tid);
+        }
+        hp.clear(tid);
+        return nullptr;
+    }
+
+    //    ,   tid
+    void release(const int tid) {
+        hp.clearOne(kHpNext, tid);
+    }
+
+    // ,    Disposer
+    size_t getRetiredCount() const {
+        return hp.getRetiredCount();
+    }
+};
+
+#endif
\ No newline at end of file
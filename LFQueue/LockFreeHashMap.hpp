@@ -0,0 +1,277 @@
+#ifndef _LOCK_FREE_HASH_MAP_H_
+#define _LOCK_FREE_HASH_MAP_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include "HazardPointers.hpp"
+
+
+template<typename K, typename V, typename Hash = std::hash<K>>
+class LockFreeHashMap {
+    /*
+    //  -     (Shalev, Shavit, 2006).
+    //         (Michael, 2002),   
+    //     .  -     ,    .
+    //       :   b    
+    //   ,      - (b   ).
+    //       .
+    //
+    //     :    next,    .
+    //     HazardPointers.    .
+    //
+    //           ; find   .
+    // K  V      (  ).
+    */
+private:
+    struct Node {
+        const uint64_t soKey;       //  :  ;   1 -  , 0 - 
+        const K key;
+        const V value;
+        std::atomic<Node*> next;    //   -  
+
+        Node(uint64_t soKey) : soKey{ soKey }, key(), value(), next{ nullptr } { }
+        Node(uint64_t soKey, const K& key, const V& value) : soKey{ soKey }, key(key), value(value), next{ nullptr } { }
+    };
+
+    enum SearchResult { NOT_FOUND, FOUND, RESTART };
+
+    static const int MAX_THREADS = 128;
+    static const int MAX_SEGMENTS = 32;         //  s > 0   [2^(s-1), 2^s)
+    static const uint64_t MAX_LOAD = 2;         //        
+
+    const int maxThreads;
+    Hash hasher;
+
+    std::atomic<std::atomic<Node*>*> segments[MAX_SEGMENTS];
+    alignas(128) std::atomic<uint64_t> bucketCount;
+    alignas(128) std::atomic<uint64_t> itemCount{ 0 };
+
+    HazardPointers<Node> hp{ 3, maxThreads };
+    const int kHpNext = 0;
+    const int kHpCur = 1;
+    const int kHpPrev = 2;
+
+    static bool isMarked(Node* node) {
+        return ((uintptr_t)node & 1) != 0;
+    }
+
+    static Node* marked(Node* node) {
+        return (Node*)((uintptr_t)node | 1);
+    }
+
+    static Node* unmarked(Node* node) {
+        return (Node*)((uintptr_t)node & ~(uintptr_t)1);
+    }
+
+    static uint64_t reverseBits(uint64_t x) {
+        x = ((x >> 1) & 0x5555555555555555ull) | ((x & 0x5555555555555555ull) << 1);
+        x = ((x >> 2) & 0x3333333333333333ull) | ((x & 0x3333333333333333ull) << 2);
+        x = ((x >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((x & 0x0F0F0F0F0F0F0F0Full) << 4);
+        x = ((x >> 8) & 0x00FF00FF00FF00FFull) | ((x & 0x00FF00FF00FF00FFull) << 8);
+        x = ((x >> 16) & 0x0000FFFF0000FFFFull) | ((x & 0x0000FFFF0000FFFFull) << 16);
+        return (x >> 32) | (x << 32);
+    }
+
+    //       (0  0)
+    static int bitLength(uint64_t x) {
+        int length = 0;
+        while (x != 0) {
+            x >>= 1;
+            length++;
+        }
+        return length;
+    }
+
+    uint64_t hashOf(const K& key) const {
+        return (uint64_t)hasher(key) & 0x7FFFFFFFFFFFFFFFull;
+    }
+
+    //  ;     
+    std::atomic<Node*>& bucketSlot(uint64_t bucket) {
+        int segment = bitLength(bucket);
+        uint64_t first = segment == 0 ? 0 : 1ull << (segment - 1);
+        std::atomic<Node*>* slots = segments[segment].load(std::memory_order_acquire);
+        if (slots == nullptr) {
+            uint64_t length = segment == 0 ? 1 : first;
+            std::atomic<Node*>* allocated = new std::atomic<Node*>[length];
+            for (uint64_t i = 0; i < length; i++)
+                allocated[i].store(nullptr, std::memory_order_relaxed);
+            if (segments[segment].compare_exchange_strong(slots, allocated)) slots = allocated;
+            else delete[] allocated;
+        }
+        return slots[bucket - first];
+    }
+
+    //   ,      -
+    Node* getBucket(uint64_t bucket, const int tid) {
+        Node* dummy = bucketSlot(bucket).load(std::memory_order_acquire);
+        if (dummy != nullptr) return dummy;
+        uint64_t parent = bucket & ~(1ull << (bitLength(bucket) - 1));
+        Node* parentDummy = getBucket(parent, tid);
+        dummy = new Node(reverseBits(bucket));
+        Node* inList = insertNode(parentDummy, dummy, tid);
+        if (inList != dummy) delete dummy;      //     
+        bucketSlot(bucket).store(inList, std::memory_order_release);
+        return inList;
+    }
+
+    //       head. prev -   cur, cur -     (FOUND)
+    //        (NOT_FOUND).     .
+    // key == nullptr -   .
+    SearchResult searchOnce(Node* head, uint64_t soKey, const K* key, std::atomic<Node*>*& prev, Node*& cur, const int tid) {
+        prev = &head->next;
+        cur = prev->load();
+        hp.protectPtr(kHpCur, cur, tid);
+        if (prev->load() != cur) return RESTART;
+        while (true) {
+            if (cur == nullptr) return NOT_FOUND;
+            Node* next = cur->next.load();
+            hp.protectPtr(kHpNext, unmarked(next), tid);
+            if (cur->next.load() != next) return RESTART;
+            if (isMarked(next)) {
+                Node* expected = cur;
+                if (!prev->compare_exchange_strong(expected, unmarked(next))) return RESTART;
+                Node* removed = cur;
+                cur = unmarked(next);
+                hp.protectPtr(kHpCur, cur, tid);
+                hp.retire(removed, tid);
+                continue;
+            }
+            if (prev->load() != cur) return RESTART;
+            if (cur->soKey > soKey) return NOT_FOUND;
+            if (cur->soKey == soKey && (key == nullptr || cur->key == *key)) return FOUND;
+            prev = &cur->next;
+            hp.protectPtr(kHpPrev, cur, tid);
+            cur = next;
+            hp.protectPtr(kHpCur, cur, tid);
+        }
+    }
+
+    bool search(Node* head, uint64_t soKey, const K* key, std::atomic<Node*>*& prev, Node*& cur, const int tid) {
+        SearchResult result;
+        while ((result = searchOnce(head, soKey, key, prev, cur, tid)) == RESTART);
+        return result == FOUND;
+    }
+
+    //      head.  node        .
+    Node* insertNode(Node* head, Node* node, const int tid) {
+        const K* key = (node->soKey & 1) != 0 ? &node->key : nullptr;
+        while (true) {
+            std::atomic<Node*>* prev;
+            Node* cur;
+            if (search(head, node->soKey, key, prev, cur, tid)) {
+                hp.clear(tid);
+                return cur;
+            }
+            node->next.store(cur, std::memory_order_relaxed);
+            if (prev->compare_exchange_strong(cur, node)) {
+                hp.clear(tid);
+                return node;
+            }
+        }
+    }
+
+public:
+    // buckets -   ,     
+    LockFreeHashMap(int maxThreads = MAX_THREADS, uint64_t buckets = 16) : maxThreads{ maxThreads } {
+        if (buckets == 0) throw std::invalid_argument("buckets must be positive");
+        uint64_t count = 1;
+        while (count < buckets) count *= 2;
+        if (bitLength(count) >= MAX_SEGMENTS) throw std::invalid_argument("too many buckets");
+        bucketCount.store(count, std::memory_order_relaxed);
+        for (int i = 0; i < MAX_SEGMENTS; i++)
+            segments[i].store(nullptr, std::memory_order_relaxed);
+        bucketSlot(0).store(new Node(0), std::memory_order_relaxed);
+    }
+
+    ~LockFreeHashMap() {
+        //       ,     
+        Node* node = bucketSlot(0).load();
+        while (node != nullptr) {
+            Node* next = unmarked(node->next.load());
+            delete node;
+            node = next;
+        }
+        for (int i = 0; i < MAX_SEGMENTS; i++)
+            delete[] segments[i].load();
+    }
+
+    LockFreeHashMap(const LockFreeHashMap&) = delete;
+    LockFreeHashMap& operator=(const LockFreeHashMap&) = delete;
+
+    //  . false -   ,   .
+    bool insert(const K& key, const V& value, const int tid) {
+        uint64_t hash = hashOf(key);
+        Node* head = getBucket(hash & (bucketCount.load() - 1), tid);
+        Node* node = new Node(reverseBits(hash) | 1, key, value);
+        if (insertNode(head, node, tid) != node) {
+            delete node;
+            return false;
+        }
+        uint64_t count = itemCount.fetch_add(1) + 1;
+        uint64_t buckets = bucketCount.load();
+        if (count / buckets > MAX_LOAD && bitLength(buckets * 2) < MAX_SEGMENTS)
+            bucketCount.compare_exchange_strong(buckets, buckets * 2);
+        return true;
+    }
+
+    // :    value. false -  .
+    bool find(const K& key, V& value, const int tid) {
+        uint64_t hash = hashOf(key);
+        Node* head = getBucket(hash & (bucketCount.load() - 1), tid);
+        std::atomic<Node*>* prev;
+        Node* cur;
+        bool found = search(head, reverseBits(hash) | 1, &key, prev, cur, tid);
+        if (found) value = cur->value;
+        hp.clear(tid);
+        return found;
+    }
+
+    //  . false -  .
+    bool erase(const K& key, const int tid) {
+        uint64_t hash = hashOf(key);
+        uint64_t soKey = reverseBits(hash) | 1;
+        Node* head = getBucket(hash & (bucketCount.load() - 1), tid);
+        while (true) {
+            std::atomic<Node*>* prev;
+            Node* cur;
+            if (!search(head, soKey, &key, prev, cur, tid)) {
+                hp.clear(tid);
+                return false;
+            }
+            Node* next = cur->next.load();
+            if (isMarked(next)) continue;
+            //  -  ;      
+            if (!cur->next.compare_exchange_strong(next, marked(next))) continue;
+            itemCount.fetch_sub(1);
+            Node* expected = cur;
+            if (prev->compare_exchange_strong(expected, next)) {
+                hp.clear(tid);
+                hp.retire(cur, tid);
+            }
+            else {
+                search(head, soKey, &key, prev, cur, tid);     //   
+                hp.clear(tid);
+            }
+            return true;
+        }
+    }
+
+    //   ()
+    uint64_t size() const {
+        return itemCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t getBucketCount() const {
+        return bucketCount.load(std::memory_order_relaxed);
+    }
+
+    //  ,      ()
+    size_t getRetiredCount() const {
+        return hp.getRetiredCount();
+    }
+};
+
+#endif
\ No newline at end of file
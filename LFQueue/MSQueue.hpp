@@ -2,25 +2,44 @@
 #define _MS_QUEUE_HP_H_
 
 #include <atomic>
+#include <cstdint>
+#include <memory>
 #include <stdio.h>
 #include <stdexcept>
+#include "CacheAligned.hpp"
+#include "EventCount.hpp"
 #include "HazardPointers.hpp"
+#include "NodeSupply.hpp"
+#include "QueueNotifier.hpp"
+#ifdef MSQUEUE_TEST_HOOKS
+#include <functional>
+#endif
 
 
 template<typename T>
-class MSQueue {
+class MSQueue : public CacheAligned {
     /* 
     //    (Lock-Free Queue).     . 
     //    Node         
     //      . 
     //     .
+    //
+    //    capacity, tryPush    ,  pushWait   .
+    //  :  push      . push   .
+    //     :         
+    //      ,     .     ,
+    //       (trackDepth);  size()  logic_error.
+    //
+    // reserve(n)    n : push    ,     ,
+    //   Hazard Pointers    .   setAllocationFree(true)
+    // push        :      false.
     */
 private:
     struct Node {
         T* item;                    //   
         std::atomic<Node*> next;    //     
 
-        Node(T* userItem) : item{ userItem }, next{ nullptr } { } // 
+        Node(T* userItem = nullptr) : item{ userItem }, next{ nullptr } { } // 
 
         // CAS (compare and swap). 
         //    next   cmp, 
@@ -54,15 +73,80 @@ private:
     static const int MAX_THREADS = 128;
     const int maxThreads;
 
+    //  ,   reserve.   hp:  hp    .
+    std::unique_ptr<NodeSupply<Node>> supply;
+    bool allocationFree = false;
+
+    static void releaseToSupply(Node* node, void* context, const int tid) {
+        ((NodeSupply<Node>*)context)->put(node, tid);
+    }
+
     //   Hazard Pointers   
     HazardPointers<Node> hp{ 4, maxThreads };
     const int kHpTail = 0;
     const int kHpHead = 0;
     const int kHpNext = 1;
 
+    //     
+    std::atomic<QueueNotifier*> notifier{ nullptr };
+
+    //  ,        folded
+    struct alignas(128) DepthDelta : CacheAligned {
+        std::atomic<int64_t> value{ 0 };
+    };
+
+    const size_t capacity;                  // 0 -  
+    const int64_t foldThreshold;            //       
+    const bool depthTracked;                //  :    trackDepth
+    std::unique_ptr<DepthDelta[]> deltas;   //   MAX_THREADS,   Hazard Pointers;   depthTracked
+    alignas(128) std::atomic<int64_t> folded{ 0 };
+    EventCount spaceAvailable;              //    pushWait
+
+    //   ,         
+    static int64_t thresholdFor(size_t capacity, int maxThreads) {
+        if (capacity == 0) return 64;
+        int64_t threshold = (int64_t)(capacity / (4 * (size_t)maxThreads));
+        return threshold < 64 ? threshold : 64;
+    }
+
+    //     tid (  depthTracked).    ,   RMW.
+    void addDepth(int64_t change, const int tid) {
+        std::atomic<int64_t>& delta = deltas[tid].value;
+        int64_t value = delta.load(std::memory_order_relaxed) + change;
+        if (value > foldThreshold) {
+            // :    ,   -    
+            delta.store(0, std::memory_order_relaxed);
+            folded.fetch_add(value, std::memory_order_relaxed);
+        }
+        else if (value < -foldThreshold) {
+            // :  ,   -     .
+            //  tryPush   ,  pushWait     .
+            folded.fetch_add(value, std::memory_order_relaxed);
+            delta.store(0, std::memory_order_relaxed);
+        }
+        else delta.store(value, std::memory_order_relaxed);
+    }
+
+    bool isFull() const {
+        if (capacity == 0) return false;
+        //     :       
+        if (folded.load(std::memory_order_relaxed) + foldThreshold * maxThreads < (int64_t)capacity) return false;
+        return size() >= capacity;
+    }
+
+#ifdef MSQUEUE_TEST_HOOKS
 public:
-    // 
-    MSQueue(int maxThreads = MAX_THREADS) : maxThreads{ maxThreads } {
+    //       .   tid  .
+    std::function<void(const int)> onPopProtected;    // pop:      ,  casHead
+    std::function<void(const int)> onTailHelp;        // push:  ,    
+#endif
+
+public:
+    // . capacity -   tryPush  pushWait, 0 -  .
+    // trackDepth -    size()    (    ).
+    MSQueue(int maxThreads = MAX_THREADS, size_t capacity = 0, bool trackDepth = false)
+        : maxThreads{ maxThreads }, capacity{ capacity }, foldThreshold{ thresholdFor(capacity, maxThreads) },
+        depthTracked{ capacity != 0 || trackDepth }, deltas{ depthTracked ? new DepthDelta[MAX_THREADS] : nullptr } {
         Node* sentinelNode = new Node(nullptr);
         head.store(sentinelNode, std::memory_order_relaxed);
         tail.store(sentinelNode, std::memory_order_relaxed);
@@ -78,11 +162,84 @@ public:
         return (head == tail);
     }
 
-    //    item   tid  
-    void push(T* item, const int tid) {
-        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
-        
-        Node* newNode = new Node(item);
+    //   :       .
+    //   ,   (. isDepthTracked).
+    size_t size() const {
+        if (!depthTracked) throw std::logic_error("size() requires a capacity or trackDepth");
+        int64_t total = folded.load(std::memory_order_relaxed);
+        for (int i = 0; i < MAX_THREADS; i++)
+            total += deltas[i].value.load(std::memory_order_relaxed);
+        return total > 0 ? (size_t)total : 0;
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    bool isDepthTracked() const {
+        return depthTracked;
+    }
+
+    //  nodes   ;          delete.
+    //      .
+    void reserve(size_t nodes) {
+        if (!supply) {
+            supply.reset(new NodeSupply<Node>(maxThreads));
+            hp.setDeleter(&MSQueue::releaseToSupply, supply.get());
+            hp.reserveRetired();
+        }
+        supply->reserve(nodes);
+    }
+
+    //    : push     .      .
+    void setAllocationFree(bool enabled) {
+        if (enabled) reserve(0);
+        allocationFree = enabled;
+    }
+
+    //    
+    size_t getReserved() const {
+        return supply ? supply->getAvailable() : 0;
+    }
+
+    //      (nullptr - ).     .
+    //    :    (, QueueSelector  EventFdNotifier ).
+    void setNotifier(QueueNotifier* newNotifier) {
+        notifier.store(newNotifier);
+    }
+
+    //  ,    Hazard Pointers
+    size_t getRetiredCount() const {
+        return hp.getRetiredCount();
+    }
+
+    //    (       )
+    static size_t getNodeSize() {
+        return sizeof(Node);
+    }
+
+    //      :  ,  Hazard Pointers, -
+    //    (  ,  )
+    static size_t getFixedFootprint(bool depthTracked = false) {
+        return sizeof(MSQueue) + HazardPointers<Node>::getHeapBytes() + (depthTracked ? MAX_THREADS * sizeof(DepthDelta) : 0)
+            + sizeof(Node);
+    }
+
+    //    item   tid  .
+    // false -      :    item == nullptr.
+    bool push(T* item, const int tid) {
+        if (item == nullptr) {
+            if (allocationFree) return false;
+            throw std::invalid_argument("item can not be nullptr");
+        }
+
+        Node* newNode = supply ? supply->get(tid) : nullptr;
+        if (newNode != nullptr) {
+            newNode->item = item;
+            newNode->next.store(nullptr, std::memory_order_relaxed);
+        }
+        else if (allocationFree) return false;
+        else newNode = new Node(item);
         while (true) {
             Node* ltail = hp.protectPtr(kHpTail, tail, tid);
             if (ltail == tail.load()) {
@@ -92,11 +249,42 @@ public:
                         //    =>   newNode      newNode
                         casTail(ltail, newNode);
                         hp.clear(tid);
-                        return;     //   
+                        if (depthTracked) addDepth(1, tid);
+                        //    ltail,     
+                        QueueNotifier* lnotifier = notifier.load();
+                        if (lnotifier != nullptr) lnotifier->notify();
+                        return true;    //   
                     }
-                } else casTail(ltail, lnext);
+                } else {
+#ifdef MSQUEUE_TEST_HOOKS
+                    if (onTailHelp) onTailHelp(tid);
+#endif
+                    casTail(ltail, lnext);
+                }
+            }
+        }
+    }
+
+    //    . false -  ,   .
+    bool tryPush(T* item, const int tid) {
+        if (isFull()) return false;
+        return push(item, tid);
+    }
+
+    //     . false -   push.
+    bool pushWait(T* item, const int tid) {
+        while (isFull()) {
+            uint64_t key = spaceAvailable.prepareWait();
+            //     pop:      , 
+            // pop    ,   -   
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!isFull()) {
+                spaceAvailable.cancelWait();
+                break;
             }
+            spaceAvailable.wait(key);
         }
+        return push(item, tid);
     }
 
     //    
@@ -104,11 +292,20 @@ public:
         Node* node = hp.protect(kHpHead, head, tid);
         while (node != tail.load()) {
             Node* lnext = hp.protect(kHpNext, node->next, tid);
+#ifdef MSQUEUE_TEST_HOOKS
+            if (onPopProtected) onPopProtected(tid);
+#endif
             if (casHead(node, lnext)) {
                 //     lnext   clear()
                 T* item = lnext->item;  
                 hp.clear(tid);
                 hp.retire(node, tid);
+                if (depthTracked) addDepth(-1, tid);
+                if (capacity != 0) {
+                    //          notifyOne
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    spaceAvailable.notifyOne();
+                }
                 return item;
             }
             node = hp.protect(kHpHead, head, tid);
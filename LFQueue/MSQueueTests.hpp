@@ -8,6 +8,7 @@
 #include <string>
 #include <time.h>
 #include "MSQueue.hpp"
+#include "QueueBenchmarks.hpp"
 
 using namespace std;
 
@@ -214,13 +215,71 @@ public:
 	MSQueueTests() {
 		try {
 			showLine();
-			cout << "|   : 1-, - = ";
+			cout << "|   : 1-, 2-   , 3- , 4- , 5-, 6- , 7- , 8-  , 9--, 10-  , 11- , 12- , 13- , 14- , 15- , 16- eventfd, 17-  , 18-, 19- , 20-  , 21-  , 22- , - = ";
 			short testMode;
 			cin >> testMode;
-			if (testMode != 1)
-				startTestByParams();
-			else
+			if (testMode == 1)
 				autoTest();
+			else if (testMode == 2)
+				QueueBenchmarks().compareBaselines();
+			else if (testMode == 3)
+				QueueBenchmarks().memoryFootprint();
+			else if (testMode == 4)
+#ifdef MSQUEUE_TEST_HOOKS
+				QueueBenchmarks().stalledThread();
+#else
+				cout << "|       MSQUEUE_TEST_HOOKS ( LockFreeQueueTestHooks)" << endl;
+#endif
+			else if (testMode == 5)
+				QueueBenchmarks().oversubscription();
+			else if (testMode == 6)
+				QueueBenchmarks().threadPool();
+			else if (testMode == 7)
+				QueueBenchmarks().workStealing();
+			else if (testMode == 8)
+				QueueBenchmarks().stackElimination();
+			else if (testMode == 9)
+				QueueBenchmarks().hashMap();
+			else if (testMode == 10)
+				QueueBenchmarks().priorityQueues();
+			else if (testMode == 11)
+				QueueBenchmarks().byteMessages();
+			else if (testMode == 12)
+				QueueBenchmarks().mailboxes();
+			else if (testMode == 13)
+				QueueBenchmarks().broadcast();
+			else if (testMode == 14)
+				QueueBenchmarks().handoff();
+			else if (testMode == 15)
+				QueueBenchmarks().delays();
+			else if (testMode == 16)
+#ifdef __linux__
+				QueueBenchmarks().eventFdNotifier();
+#else
+				cout << "|     Linux (eventfd)" << endl;
+#endif
+			else if (testMode == 17)
+				QueueBenchmarks().queueSelector();
+			else if (testMode == 18)
+				QueueBenchmarks().pipeline();
+			else if (testMode == 19)
+#if defined(__unix__) || defined(__APPLE__)
+				QueueBenchmarks().sharedMemoryQueue();
+#else
+				cout << "|     POSIX (shm_open)" << endl;
+#endif
+			else if (testMode == 20)
+#if defined(__unix__) || defined(__APPLE__)
+				QueueBenchmarks().spillQueue();
+#else
+				cout << "|     POSIX (mmap)" << endl;
+#endif
+			else if (testMode == 21)
+				QueueBenchmarks().boundedQueue();
+			else if (testMode == 22)
+				QueueBenchmarks().nodePool();
+			else
+				startTestByParams();
 		}
 		catch (const exception & error) {
 			cout << error.what() << endl;
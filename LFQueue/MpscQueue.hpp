@@ -0,0 +1,93 @@
+#ifndef _MPSC_QUEUE_H_
+#define _MPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include "IntrusiveQueue.hpp"
+
+
+template<typename T>
+class MpscQueue {
+    /*
+    //        ():  , .
+    // T   IntrusiveHook. push -  exchange  tail   next  ;
+    //    next  CAS   Hazard Pointers.     
+    // ,      (stub),    ,     .
+    //      :      .
+    //
+    // pop  drain    .     exchange,     next,
+    // pop  nullptr,    :      .
+    */
+    static_assert(std::is_base_of<IntrusiveHook, T>::value, "T must derive from IntrusiveHook");
+
+private:
+    alignas(128) std::atomic<IntrusiveHook*> tail;     //  ,   
+    alignas(128) IntrusiveHook* head;                   //  ,   
+    IntrusiveHook stub;
+
+    void pushHook(IntrusiveHook* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        IntrusiveHook* prev = tail.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+public:
+    MpscQueue() : tail{ &stub }, head{ &stub } { }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // ,   ,  :   
+    void push(T* item) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        pushHook(item);
+    }
+
+    //   ( ), nullptr -  
+    T* pop() {
+        IntrusiveHook* lhead = head;
+        IntrusiveHook* lnext = lhead->next.load(std::memory_order_acquire);
+        if (lhead == &stub) {
+            if (lnext == nullptr) return nullptr;
+            head = lnext;
+            lhead = lnext;
+            lnext = lnext->next.load(std::memory_order_acquire);
+        }
+        if (lnext != nullptr) {
+            head = lnext;
+            return static_cast<T*>(lhead);
+        }
+        // lhead -         next
+        if (lhead != tail.load(std::memory_order_acquire)) return nullptr;
+        pushHook(&stub);
+        lnext = lhead->next.load(std::memory_order_acquire);
+        if (lnext != nullptr) {
+            head = lnext;
+            return static_cast<T*>(lhead);
+        }
+        return nullptr;
+    }
+
+    //   max      handler(T*) ( ).
+    //    .
+    template<typename F>
+    size_t drain(F&& handler, size_t max = SIZE_MAX) {
+        size_t count = 0;
+        T* item;
+        while (count < max && (item = pop()) != nullptr) {
+            handler(item);
+            count++;
+        }
+        return count;
+    }
+
+    //  .  head -  ,     .
+    bool isEmpty() const {
+        return head == &stub && stub.next.load(std::memory_order_acquire) == nullptr;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef _NODE_SUPPLY_H_
+#define _NODE_SUPPLY_H_
+
+#include <atomic>
+#include <cstddef>
+#include "HazardPointers.hpp"
+#include "CacheAligned.hpp"
+
+
+template<typename Node>
+class NodeSupply : public CacheAligned {
+    /*
+    //          .
+    //      ,    next  (std::atomic<Node*>).
+    //
+    //      Hazard Pointer,      retire
+    //  HazardPointers :    ,        
+    //  .          next  CAS (ABA).
+    //  reserve  get,  put   .
+    */
+private:
+    static const int MAX_THREADS = 128;
+    const int maxThreads;
+
+    alignas(128) std::atomic<Node*> top{ nullptr };
+    alignas(128) std::atomic<size_t> available{ 0 };
+
+    HazardPointers<Node> hp{ 1, maxThreads };
+    const int kHpTop = 0;
+
+    void pushFree(Node* node) {
+        Node* ltop = top.load();
+        do {
+            node->next.store(ltop, std::memory_order_relaxed);
+        } while (!top.compare_exchange_weak(ltop, node));
+        available.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void releaseToStack(Node* node, void* context, const int /*tid*/) {
+        ((NodeSupply*)context)->pushFree(node);
+    }
+
+public:
+    NodeSupply(int maxThreads = MAX_THREADS) : maxThreads{ maxThreads } {
+        hp.setDeleter(&NodeSupply::releaseToStack, this);
+    }
+
+    ~NodeSupply() {
+        hp.setDeleter(nullptr, nullptr);     // ,   hp,   
+        Node* node = top.load();
+        while (node != nullptr) {
+            Node* next = node->next.load();
+            delete node;
+            node = next;
+        }
+    }
+
+    NodeSupply(const NodeSupply&) = delete;
+    NodeSupply& operator=(const NodeSupply&) = delete;
+
+    //  count     .    .
+    void reserve(size_t count) {
+        hp.reserveRetired();
+        for (size_t i = 0; i < count; i++)
+            pushFree(new Node());
+    }
+
+    //    nullptr,   .      .
+    Node* get(const int tid) {
+        while (true) {
+            Node* node = hp.protect(kHpTop, top, tid);
+            if (node == nullptr) {
+                hp.clear(tid);
+                return nullptr;
+            }
+            Node* next = node->next.load();
+            if (top.compare_exchange_strong(node, next)) {
+                hp.clear(tid);
+                available.fetch_sub(1, std::memory_order_relaxed);
+                return node;
+            }
+        }
+    }
+
+    //    
+    void put(Node* node, const int tid) {
+        hp.retire(node, tid);
+    }
+
+    //     (; ,   hp,  )
+    size_t getAvailable() const {
+        return available.load(std::memory_order_relaxed);
+    }
+};
+
+#endif
\ No newline at end of file
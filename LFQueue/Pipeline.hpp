@@ -0,0 +1,212 @@
+#ifndef _PIPELINE_H_
+#define _PIPELINE_H_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MSQueue.hpp"
+#include "CacheAligned.hpp"
+#include "EventCount.hpp"
+#include "ThreadRegistry.hpp"
+
+
+template<typename T>
+class Pipeline {
+    /*
+    //  ,   MSQueue: parse -> transform -> serialize.
+    //            batch .
+    //           ( ,
+    //    ).      .
+    //
+    //   :      capacity .  
+    // ,  (  push    )  ,   
+    // ,  .    ,      
+    //     -     .
+    //
+    //     Pipeline<Message> pipeline;
+    //     pipeline.stage("parse", parse, 2).stage("serialize", serialize, 1, 64);
+    //     pipeline.start();
+    //     pipeline.push(message);      // ,    
+    //     pipeline.finish();           //   ,   
+    */
+public:
+    using Handler = std::function<void(std::vector<T*>& batch)>;
+
+    struct StageStats {
+        std::string name;
+        unsigned long long processed;   //  
+        double throughput;              //      start()
+        long depth;                     //     ()
+        long capacity;                  //   
+    };
+
+private:
+    struct Stage : CacheAligned {
+        std::string name;
+        Handler handler;
+        unsigned threads;
+        unsigned batch;
+        long capacity;
+
+        MSQueue<T> input{ ThreadRegistry::MAX_THREADS };
+        alignas(128) std::atomic<long> credits;
+        alignas(128) std::atomic<unsigned long long> processed{ 0 };
+        std::atomic<bool> closed{ false };      //     
+        std::atomic<unsigned> running{ 0 };     //   
+        EventCount itemsAvailable;
+        EventCount spaceAvailable;
+        std::vector<std::thread> workers;
+
+        Stage(const std::string& name, Handler handler, unsigned threads, unsigned batch, long capacity)
+            : name{ name }, handler{ handler }, threads{ threads }, batch{ batch }, capacity{ capacity }, credits{ capacity } { }
+
+        bool tryAcquireCredit() {
+            long available = credits.load();
+            while (available > 0)
+                if (credits.compare_exchange_weak(available, available - 1)) return true;
+            return false;
+        }
+
+        //     ,  
+        void put(T* item, const int tid) {
+            while (!tryAcquireCredit()) {
+                uint64_t key = spaceAvailable.prepareWait();
+                if (credits.load() > 0) {
+                    spaceAvailable.cancelWait();
+                    continue;
+                }
+                spaceAvailable.wait(key);
+            }
+            input.push(item, tid);
+            itemsAvailable.notifyOne();
+        }
+
+        //   batch ;   -     
+        void take(std::vector<T*>& items, const int tid, unsigned spinCount) {
+            items.clear();
+            unsigned spins = 0;
+            while (true) {
+                bool wasClosed = closed.load();
+                T* item;
+                while (items.size() < batch && (item = input.pop(tid)) != nullptr)
+                    items.push_back(item);
+                if (!items.empty() || wasClosed) break;
+                if (++spins < spinCount) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                uint64_t key = itemsAvailable.prepareWait();
+                if (!input.isEmpty() || closed.load()) {
+                    itemsAvailable.cancelWait();
+                    continue;
+                }
+                itemsAvailable.wait(key);
+            }
+            if (!items.empty()) {
+                credits.fetch_add((long)items.size());
+                if (items.size() > 1) spaceAvailable.notifyAll();
+                else spaceAvailable.notifyOne();
+            }
+        }
+    };
+
+    std::vector<std::unique_ptr<Stage>> stages;
+    std::chrono::steady_clock::time_point startTime;
+    bool started = false;
+    const unsigned spinCount;
+
+    void workerLoop(size_t index) {
+        Stage& stage = *stages[index];
+        Stage* next = index + 1 < stages.size() ? stages[index + 1].get() : nullptr;
+        const int tid = ThreadRegistry::current();
+        std::vector<T*> items;
+        items.reserve(stage.batch);
+        while (true) {
+            stage.take(items, tid, spinCount);
+            if (items.empty()) break;
+            stage.handler(items);
+            stage.processed.fetch_add(items.size(), std::memory_order_relaxed);
+            if (next != nullptr)
+                for (T* item : items)
+                    if (item != nullptr) next->put(item, tid);
+        }
+        //       
+        if (stage.running.fetch_sub(1) == 1 && next != nullptr) {
+            next->closed.store(true);
+            next->itemsAvailable.notifyAll();
+        }
+    }
+
+public:
+    Pipeline(unsigned spinCount = 64) : spinCount{ spinCount } { }
+
+    ~Pipeline() {
+        if (started) finish();
+    }
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    //  . threads -  , batch -   ,
+    // capacity -    .
+    Pipeline& stage(const std::string& name, Handler handler, unsigned threads = 1, unsigned batch = 1, long capacity = 1024) {
+        if (started) throw std::logic_error("pipeline already started");
+        if (threads == 0 || batch == 0 || capacity <= 0) throw std::invalid_argument("threads, batch and capacity must be positive");
+        stages.emplace_back(new Stage(name, handler, threads, batch, capacity));
+        return *this;
+    }
+
+    void start() {
+        if (started) throw std::logic_error("pipeline already started");
+        if (stages.empty()) throw std::logic_error("pipeline has no stages");
+        started = true;
+        startTime = std::chrono::steady_clock::now();
+        for (auto& stage : stages)
+            stage->running.store(stage->threads);
+        for (size_t index = 0; index < stages.size(); index++)
+            for (unsigned t = 0; t < stages[index]->threads; t++)
+                stages[index]->workers.emplace_back(&Pipeline::workerLoop, this, index);
+    }
+
+    //     . ,      .
+    void push(T* item) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        stages.front()->put(item, ThreadRegistry::current());
+    }
+
+    //    ,      .
+    //  push    finish().
+    void finish() {
+        if (!started) return;
+        stages.front()->closed.store(true);
+        stages.front()->itemsAvailable.notifyAll();
+        for (auto& stage : stages)
+            for (auto& worker : stage->workers)
+                worker.join();
+        for (auto& stage : stages)
+            stage->workers.clear();
+        started = false;
+    }
+
+    std::vector<StageStats> stats() const {
+        double seconds = started ? std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() : 0;
+        std::vector<StageStats> result;
+        for (auto& stage : stages) {
+            StageStats stats;
+            stats.name = stage->name;
+            stats.processed = stage->processed.load(std::memory_order_relaxed);
+            stats.throughput = seconds > 0 ? stats.processed / seconds : 0;
+            stats.capacity = stage->capacity;
+            stats.depth = stage->capacity - stage->credits.load(std::memory_order_relaxed);
+            result.push_back(stats);
+        }
+        return result;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef _PRIORITY_LANE_QUEUE_H_
+#define _PRIORITY_LANE_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include "MSQueue.hpp"
+
+
+template<typename T>
+class PriorityLaneQueue {
+    /*
+    //    :   MSQueue   ( 64 )  
+    //    .  0 -  .
+    // pop          O(1)     .
+    //    FIFO.
+    //
+    // push        . pop,   ,  
+    //     :  push     ,  .
+    //        ,       .
+    //      : pop    ,   .
+    //    pop     push; pop,    push, 
+    //       nullptr.
+    //
+    //   -  MSQueue   Hazard Pointers:  50   ,
+    //  3   64 .     ,    .
+    */
+private:
+    static const int MAX_THREADS = 128;
+    static const unsigned MAX_LEVELS = 64;
+
+    std::vector<std::unique_ptr<MSQueue<T>>> lanes;
+    alignas(128) std::atomic<uint64_t> nonEmpty{ 0 };
+
+    //     (bits != 0)
+    static unsigned lowestBit(uint64_t bits) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return (unsigned)index;
+#else
+        return (unsigned)__builtin_ctzll(bits);
+#endif
+    }
+
+public:
+    PriorityLaneQueue(int maxThreads = MAX_THREADS, unsigned levels = MAX_LEVELS) {
+        if (levels == 0 || levels > MAX_LEVELS) throw std::invalid_argument("levels must be in [1, 64]");
+        for (unsigned i = 0; i < levels; i++)
+            lanes.emplace_back(new MSQueue<T>(maxThreads));
+    }
+
+    PriorityLaneQueue(const PriorityLaneQueue&) = delete;
+    PriorityLaneQueue& operator=(const PriorityLaneQueue&) = delete;
+
+    unsigned getLevels() const {
+        return (unsigned)lanes.size();
+    }
+
+    void push(unsigned level, T* item, const int tid) {
+        if (level >= lanes.size()) throw std::out_of_range("level out of range");
+        lanes[level]->push(item, tid);
+        const uint64_t bit = 1ull << level;
+        if ((nonEmpty.load() & bit) == 0) nonEmpty.fetch_or(bit);
+    }
+
+    //     , nullptr -  .  level ( ) -  .
+    T* pop(const int tid, unsigned* level = nullptr) {
+        uint64_t bits = nonEmpty.load();
+        while (bits != 0) {
+            unsigned lane = lowestBit(bits);
+            T* item = lanes[lane]->pop(tid);
+            if (item != nullptr) {
+                if (level != nullptr) *level = lane;
+                return item;
+            }
+            const uint64_t bit = 1ull << lane;
+            nonEmpty.fetch_and(~bit);
+            if (!lanes[lane]->isEmpty()) nonEmpty.fetch_or(bit);
+            bits = nonEmpty.load();
+        }
+        return nullptr;
+    }
+
+    bool isEmpty() const {
+        return nonEmpty.load() == 0;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,2250 @@
+#ifndef _QUEUE_BENCHMARKS_H_
+#define _QUEUE_BENCHMARKS_H_
+
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MSQueue.hpp"
+#include "BaselineQueues.hpp"
+#include "ThreadPool.hpp"
+#include "ChaseLevDeque.hpp"
+#include "TreiberStack.hpp"
+#include "LockFreeHashMap.hpp"
+#include "SkipListPriorityQueue.hpp"
+#include "PriorityLaneQueue.hpp"
+#include "ByteRing.hpp"
+#include "IntrusiveQueue.hpp"
+#include "MpscQueue.hpp"
+#include "BroadcastRing.hpp"
+#include "DualQueue.hpp"
+#include "DelayQueue.hpp"
+#include "QueueSelector.hpp"
+#include "Pipeline.hpp"
+#ifdef __linux__
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include "EventFdNotifier.hpp"
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include "ShmQueue.hpp"
+#include "SpillQueue.hpp"
+#endif
+
+using namespace std;
+
+struct WorkloadResult {
+	//     ( )   
+	string benchmark;			//  
+	string queue;				//  
+	unsigned writers = 0;
+	unsigned readers = 0;
+	unsigned requestedThreads = 0;	//   ,     MAX_TIDS (0 -  )
+	vector<double> throughput;	//    , /
+	vector<double> pushLatencyNs;	//    push, 
+	vector<double> popLatencyNs;	//     pop, 
+	vector<pair<string, double>> counters;	//   (  )
+
+	double median() const {
+		return percentile(throughput, 0.5);
+	}
+
+	//  q (0..1) , 0   
+	static double percentile(vector<double> sample, double q) {
+		if (sample.empty()) return 0;
+		sort(sample.begin(), sample.end());
+		double pos = q * (sample.size() - 1);
+		size_t low = (size_t)pos;
+		if (low + 1 >= sample.size()) return sample.back();
+		return sample[low] + (pos - low) * (sample[low + 1] - sample[low]);
+	}
+
+	void setCounter(const string& name, double value) {
+		for (auto& counter : counters)
+			if (counter.first == name) {
+				counter.second = max(counter.second, value);
+				return;
+			}
+		counters.push_back(make_pair(name, value));
+	}
+};
+
+class QueueBenchmarks {
+	//    MSQueue        ( x )
+	unsigned itemsPerRun = 1 << 20;		//        
+	unsigned repeats = 5;				//  ,  
+	unsigned maxThreads;				//      
+	static const unsigned MAX_TIDS = 128;	//   Hazard Pointers: tid   
+	unsigned latencyStride = 64;		//    latencyStride-  (0 -  )
+
+	void showLine() {
+		cout << "+=================================================================================+" << endl;
+	}
+
+	//   : 1, 2, 4, ...        maxThreads
+	vector<unsigned> threadSteps() {
+		vector<unsigned> steps;
+		for (unsigned n = 1; n < maxThreads; n *= 2)
+			steps.push_back(n);
+		return steps;
+	}
+
+	//  : writers   itemsPerRun , readers   .
+	//             ,
+	// FIFO ,     .
+	//   result,      .
+	template<typename Q>
+	double runTransferOnce(Q& queue, unsigned writers, unsigned readers, WorkloadResult* result = nullptr) {
+		unsigned perWriter = itemsPerRun / writers;
+		vector<int> items(perWriter * writers);
+		int stopMark = -1;
+		atomic<bool> start(false);
+		const unsigned stride = result != nullptr ? latencyStride : 0;
+		vector<vector<double>> pushLatency(writers), popLatency(readers);
+
+		vector<thread> writerThreads, readerThreads;
+		for (unsigned w = 0; w < writers; w++)
+			writerThreads.emplace_back([&, w]() {
+				vector<double>& latency = pushLatency[w];
+				unsigned n = 0;
+				while (!start.load(memory_order_acquire));
+				for (unsigned i = w * perWriter; i < (w + 1) * perWriter; i++) {
+					if (stride != 0 && ++n == stride) {
+						n = 0;
+						auto opStart = chrono::steady_clock::now();
+						queue.push(&items[i], w);
+						latency.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - opStart).count());
+					}
+					else queue.push(&items[i], w);
+				}
+			});
+		for (unsigned r = 0; r < readers; r++)
+			readerThreads.emplace_back([&, r]() {
+				const int tid = writers + r;
+				vector<double>& latency = popLatency[r];
+				unsigned n = 0;
+				while (!start.load(memory_order_acquire));
+				while (true) {
+					int* item;
+					if (stride != 0 && ++n == stride) {
+						n = 0;
+						auto opStart = chrono::steady_clock::now();
+						item = queue.pop(tid);
+						double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - opStart).count();
+						if (item != nullptr) latency.push_back(ns);
+					}
+					else item = queue.pop(tid);
+					if (item == &stopMark) break;
+				}
+			});
+
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		for (auto& t : writerThreads) t.join();
+		for (unsigned r = 0; r < readers; r++)
+			queue.push(&stopMark, 0);	//   0  ,  tid 
+		for (auto& t : readerThreads) t.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+		if (result != nullptr) {
+			for (auto& latency : pushLatency)
+				result->pushLatencyNs.insert(result->pushLatencyNs.end(), latency.begin(), latency.end());
+			for (auto& latency : popLatency)
+				result->popLatencyNs.insert(result->popLatencyNs.end(), latency.begin(), latency.end());
+		}
+		return items.size() / seconds;
+	}
+
+	//    .     .
+	template<typename Q>
+	void collectCounters(Q& queue, WorkloadResult& result) { }
+
+	void collectCounters(MSQueue<int>& queue, WorkloadResult& result) {
+		result.setCounter("retired_nodes", (double)queue.getRetiredCount());
+	}
+
+	//   key  /proc/self/status   (VmRSS, VmHWM), 0  
+	static size_t readProcStatus(const string& key) {
+#ifdef __linux__
+		ifstream status("/proc/self/status");
+		string line;
+		while (getline(status, line))
+			if (line.compare(0, key.size() + 1, key + ":") == 0)
+				return stoul(line.substr(key.size() + 1));
+#endif
+		return 0;
+	}
+
+	template<typename Q>
+	WorkloadResult runTransfer(const string& name, unsigned writers, unsigned readers) {
+		WorkloadResult result;
+		result.benchmark = "transfer";
+		result.queue = name;
+		result.writers = writers;
+		result.readers = readers;
+		for (unsigned i = 0; i < repeats; i++) {
+			Q queue(writers + readers);
+			result.throughput.push_back(runTransferOnce(queue, writers, readers, &result));
+			collectCounters(queue, result);
+		}
+		return result;
+	}
+
+	//  :    (, )      
+	vector<WorkloadResult> runMatrix() {
+		vector<WorkloadResult> results;
+		vector<unsigned> steps = threadSteps();
+		for (unsigned writers : steps)
+			for (unsigned readers : steps) {
+				if (writers + readers > maxThreads) continue;
+				results.push_back(runTransfer<MSQueue<int>>("MSQueue", writers, readers));
+				results.push_back(runTransfer<MutexQueue<int>>("MutexQueue", writers, readers));
+				results.push_back(runTransfer<TwoLockQueue<int>>("TwoLockQueue", writers, readers));
+				results.push_back(runTransfer<SpinRingQueue<int>>("SpinRingQueue", writers, readers));
+			}
+		return results;
+	}
+
+	//  push/pop  threads    durationMs   .   ,
+	//         . noiseThreads   
+	//  (SCHED_OTHER)         .
+	// : fairness_jain -        (1 - ),
+	// min_max_ratio -       ,
+	// tail_help_rate -  push,        ( MSQueue  
+	//  MSQUEUE_TEST_HOOKS;       ,    ).
+	template<typename Q>
+	WorkloadResult runPairs(const string& name, unsigned threads, unsigned noiseThreads, unsigned durationMs) {
+		WorkloadResult result;
+		result.benchmark = noiseThreads ? "oversubscribed+noise" : "oversubscribed";
+		result.queue = name;
+		result.writers = threads;
+		result.readers = threads;
+		const unsigned pad = 128 / sizeof(atomic<unsigned long long>);
+
+		for (unsigned repeat = 0; repeat < repeats; repeat++) {
+			Q queue(threads);
+			unique_ptr<atomic<unsigned long long>[]> ops(new atomic<unsigned long long>[threads * pad]);
+			unique_ptr<atomic<unsigned long long>[]> helps(new atomic<unsigned long long>[threads * pad]);
+			for (unsigned t = 0; t < threads; t++) {
+				ops[t * pad].store(0);
+				helps[t * pad].store(0);
+			}
+			countTailHelps(queue, helps.get(), pad);
+			atomic<bool> start(false), running(true);
+			int item = 0;
+
+			vector<thread> noise;
+			for (unsigned n = 0; n < noiseThreads; n++)
+				noise.emplace_back([&]() {
+					volatile unsigned long long spin = 0;
+					while (running.load(memory_order_relaxed)) spin++;
+				});
+			vector<thread> workers;
+			for (unsigned t = 0; t < threads; t++)
+				workers.emplace_back([&, t]() {
+					while (!start.load(memory_order_acquire)) this_thread::yield();
+					while (running.load(memory_order_relaxed)) {
+						queue.push(&item, t);
+						queue.pop(t);
+						ops[t * pad].store(ops[t * pad].load(memory_order_relaxed) + 1, memory_order_relaxed);
+					}
+				});
+
+			auto begin = chrono::steady_clock::now();
+			start.store(true, memory_order_release);
+			this_thread::sleep_for(chrono::milliseconds(durationMs));
+			running.store(false);
+			for (auto& t : workers) t.join();
+			double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+			for (auto& t : noise) t.join();
+
+			double sum = 0, sumSquares = 0, minOps = 0, maxOps = 0, totalHelps = 0;
+			for (unsigned t = 0; t < threads; t++) {
+				double x = (double)ops[t * pad].load();
+				sum += x;
+				sumSquares += x * x;
+				minOps = t == 0 ? x : min(minOps, x);
+				maxOps = max(maxOps, x);
+				totalHelps += (double)helps[t * pad].load();
+			}
+			result.throughput.push_back(sum / seconds);
+			if (sumSquares > 0) result.setCounter("fairness_jain", sum * sum / (threads * sumSquares));
+			if (maxOps > 0) result.setCounter("min_max_ratio", minOps / maxOps);
+#ifdef MSQUEUE_TEST_HOOKS
+			if (sum > 0) result.setCounter("tail_help_rate", totalHelps / sum);
+#endif
+		}
+		return result;
+	}
+
+	//        MSQueue.     .
+	template<typename Q>
+	void countTailHelps(Q& queue, atomic<unsigned long long>* helps, unsigned pad) { }
+
+	void countTailHelps(MSQueue<int>& queue, atomic<unsigned long long>* helps, unsigned pad) {
+#ifdef MSQUEUE_TEST_HOOKS
+		queue.onTailHelp = [helps, pad](const int tid) {
+			helps[tid * pad].store(helps[tid * pad].load(memory_order_relaxed) + 1, memory_order_relaxed);
+		};
+#endif
+	}
+
+	//     ,    runPairs
+	struct PlainTreiberStack : TreiberStack<int> {
+		PlainTreiberStack(int maxThreads) : TreiberStack<int>(maxThreads, 0) { }
+	};
+
+	//      :      depth - 1
+	struct TreeTask {
+		unsigned depth;
+	};
+
+	//    :      Chase-Lev,    LIFO,
+	//       .  steals    .
+	double runStealingTree(unsigned threads, unsigned treeDepth, unsigned long long& steals) {
+		vector<unique_ptr<ChaseLevDeque<TreeTask>>> deques;
+		for (unsigned t = 0; t < threads; t++)
+			deques.emplace_back(new ChaseLevDeque<TreeTask>(threads));
+		atomic<unsigned long long> pending(1), stolen(0);
+		atomic<bool> start(false);
+		deques[0]->push(new TreeTask{ treeDepth }, 0);
+
+		vector<thread> workers;
+		for (unsigned t = 0; t < threads; t++)
+			workers.emplace_back([&, t]() {
+				ChaseLevDeque<TreeTask>& own = *deques[t];
+				unsigned long long localSteals = 0;
+				while (!start.load(memory_order_acquire));
+				while (pending.load(memory_order_relaxed) != 0) {
+					TreeTask* task = own.pop(t);
+					for (unsigned i = 1; task == nullptr && i < threads; i++)
+						if ((task = deques[(t + i) % threads]->steal(t)) != nullptr) localSteals++;
+					if (task == nullptr) {
+						this_thread::yield();
+						continue;
+					}
+					if (task->depth > 0) {
+						pending.fetch_add(2);
+						own.push(new TreeTask{ task->depth - 1 }, t);
+						own.push(new TreeTask{ task->depth - 1 }, t);
+					}
+					delete task;
+					pending.fetch_sub(1);
+				}
+				stolen.fetch_add(localSteals);
+			});
+
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		for (auto& t : workers) t.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		steals = stolen.load();
+		return ((2ull << treeDepth) - 1) / seconds;
+	}
+
+	//    ,           MSQueue
+	double runSharedQueueTree(unsigned threads, unsigned treeDepth) {
+		MSQueue<TreeTask> queue(threads);
+		atomic<unsigned long long> pending(1);
+		atomic<bool> start(false);
+		queue.push(new TreeTask{ treeDepth }, 0);
+
+		vector<thread> workers;
+		for (unsigned t = 0; t < threads; t++)
+			workers.emplace_back([&, t]() {
+				while (!start.load(memory_order_acquire));
+				while (pending.load(memory_order_relaxed) != 0) {
+					TreeTask* task = queue.pop(t);
+					if (task == nullptr) {
+						this_thread::yield();
+						continue;
+					}
+					if (task->depth > 0) {
+						pending.fetch_add(2);
+						queue.push(new TreeTask{ task->depth - 1 }, t);
+						queue.push(new TreeTask{ task->depth - 1 }, t);
+					}
+					delete task;
+					pending.fetch_sub(1);
+				}
+			});
+
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		for (auto& t : workers) t.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		return ((2ull << treeDepth) - 1) / seconds;
+	}
+
+	//      -: threads    durationMs  find
+	//   findPercent %,    insert  erase.    [0, keyRange),
+	//     .
+	template<typename M>
+	double runMapMixOnce(unsigned threads, unsigned findPercent, unsigned keyRange, unsigned durationMs) {
+		M map(threads);
+		for (unsigned key = 0; key < keyRange; key += 2)
+			map.insert(key, key, 0);
+		const unsigned pad = 128 / sizeof(atomic<unsigned long long>);
+		unique_ptr<atomic<unsigned long long>[]> ops(new atomic<unsigned long long>[threads * pad]);
+		atomic<bool> start(false), running(true);
+
+		vector<thread> workers;
+		for (unsigned t = 0; t < threads; t++)
+			workers.emplace_back([&, t]() {
+				unsigned long long random = 0x9E3779B97F4A7C15ull * (t + 1), count = 0, value;
+				while (!start.load(memory_order_acquire)) this_thread::yield();
+				while (running.load(memory_order_relaxed)) {
+					random ^= random << 13;
+					random ^= random >> 7;
+					random ^= random << 17;
+					unsigned long long key = random % keyRange;
+					unsigned op = (unsigned)((random >> 40) % 100);
+					if (op < findPercent) map.find(key, value, t);
+					else if (op % 2 == 0) map.insert(key, key, t);
+					else map.erase(key, t);
+					count++;
+				}
+				ops[t * pad].store(count);
+			});
+
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		this_thread::sleep_for(chrono::milliseconds(durationMs));
+		running.store(false);
+		for (auto& t : workers) t.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		double sum = 0;
+		for (unsigned t = 0; t < threads; t++)
+			sum += (double)ops[t * pad].load();
+		return sum / seconds;
+	}
+
+	template<typename M>
+	double runMapMix(unsigned threads, unsigned findPercent, unsigned keyRange, unsigned durationMs) {
+		vector<double> throughput;
+		for (unsigned repeat = 0; repeat < repeats; repeat++)
+			throughput.push_back(runMapMixOnce<M>(threads, findPercent, keyRange, durationMs));
+		return WorkloadResult::percentile(throughput, 0.5);
+	}
+
+	//  push/pop    : threads    durationMs  
+	//     [0, keyRange)   .     prefill .
+	//   ,  push+pop  .
+	template<typename Q>
+	double runPriorityPairs(unsigned threads, unsigned keyRange, unsigned prefill, unsigned durationMs) {
+		const unsigned pad = 128 / sizeof(atomic<unsigned long long>);
+		vector<double> throughput;
+		int item = 0;
+		for (unsigned repeat = 0; repeat < repeats; repeat++) {
+			Q queue(threads);
+			for (unsigned i = 0; i < prefill; i++)
+				queue.push((i * 2654435761u) % keyRange, &item, 0);
+			unique_ptr<atomic<unsigned long long>[]> ops(new atomic<unsigned long long>[threads * pad]);
+			atomic<bool> start(false), running(true);
+
+			vector<thread> workers;
+			for (unsigned t = 0; t < threads; t++)
+				workers.emplace_back([&, t]() {
+					unsigned long long random = 0x9E3779B97F4A7C15ull * (t + 1), count = 0;
+					while (!start.load(memory_order_acquire)) this_thread::yield();
+					while (running.load(memory_order_relaxed)) {
+						random ^= random << 13;
+						random ^= random >> 7;
+						random ^= random << 17;
+						queue.push((unsigned)(random % keyRange), &item, t);
+						queue.pop(t);
+						count++;
+					}
+					ops[t * pad].store(count);
+				});
+
+			auto begin = chrono::steady_clock::now();
+			start.store(true, memory_order_release);
+			this_thread::sleep_for(chrono::milliseconds(durationMs));
+			running.store(false);
+			for (auto& t : workers) t.join();
+			double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+			double sum = 0;
+			for (unsigned t = 0; t < threads; t++)
+				sum += (double)ops[t * pad].load();
+			throughput.push_back(sum / seconds);
+		}
+		return WorkloadResult::percentile(throughput, 0.5);
+	}
+
+	//     : producers    durationMs  
+	//  messageSize ,   .  ring == true    ByteRing,
+	//  -  MSQueue      .    .
+	double runByteMessagesOnce(bool ring, unsigned producers, unsigned messageSize, unsigned durationMs) {
+		ByteRing bytes(1 << 20, producers == 1);
+		MSQueue<char> pointers(producers + 1);
+		atomic<bool> start(false), running(true);
+		atomic<unsigned> finished(0), touched(0);
+		unsigned long long received = 0;
+
+		vector<thread> workers;
+		for (unsigned t = 0; t < producers; t++)
+			workers.emplace_back([&, t]() {
+				while (!start.load(memory_order_acquire)) this_thread::yield();
+				while (running.load(memory_order_relaxed)) {
+					if (ring) {
+						void* span = bytes.reserve(messageSize);
+						if (span == nullptr) {
+							this_thread::yield();
+							continue;
+						}
+						memset(span, (int)t, messageSize);
+						bytes.commit(span);
+					}
+					else {
+						char* message = new char[messageSize];
+						memset(message, (int)t, messageSize);
+						pointers.push(message, t);
+					}
+				}
+				finished.fetch_add(1);
+			});
+		workers.emplace_back([&]() {
+			const int tid = (int)producers;
+			unsigned checksum = 0;     //      
+			while (!start.load(memory_order_acquire)) this_thread::yield();
+			while (true) {
+				bool done = finished.load() == producers;
+				bool any = false;
+				if (ring) {
+					uint64_t size;
+					while (const void* message = bytes.peek(size)) {
+						checksum += *(const unsigned char*)message;
+						bytes.release();
+						received++;
+						any = true;
+					}
+				}
+				else {
+					while (char* message = pointers.pop(tid)) {
+						checksum += (unsigned char)message[0];
+						delete[] message;
+						received++;
+						any = true;
+					}
+				}
+				if (done && !any) break;
+				if (!any) this_thread::yield();
+			}
+			touched.store(checksum, memory_order_relaxed);
+		});
+
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		this_thread::sleep_for(chrono::milliseconds(durationMs));
+		running.store(false);
+		for (auto& t : workers) t.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		return received / seconds;
+	}
+
+	double runByteMessages(bool ring, unsigned producers, unsigned messageSize, unsigned durationMs) {
+		vector<double> throughput;
+		for (unsigned repeat = 0; repeat < repeats; repeat++)
+			throughput.push_back(runByteMessagesOnce(ring, producers, messageSize, durationMs));
+		return WorkloadResult::percentile(throughput, 0.5);
+	}
+
+	//   :    MSQueue,    
+	struct MailMessage : IntrusiveHook {
+		unsigned long long payload;
+		MailMessage(unsigned long long payload) : payload{ payload } { }
+	};
+
+	static void sendMail(MSQueue<MailMessage>& queue, MailMessage* message, const int tid) {
+		queue.push(message, tid);
+	}
+
+	static void sendMail(IntrusiveQueue<MailMessage>& queue, MailMessage* message, const int tid) {
+		queue.push(message, tid);
+	}
+
+	static void sendMail(MpscQueue<MailMessage>& queue, MailMessage* message, const int tid) {
+		queue.push(message);
+	}
+
+	static size_t receiveMail(MSQueue<MailMessage>& queue, const int tid) {
+		size_t count = 0;
+		while (MailMessage* message = queue.pop(tid)) {
+			delete message;
+			count++;
+		}
+		return count;
+	}
+
+	//    
+	static size_t receiveMail(IntrusiveQueue<MailMessage>& queue, const int tid) {
+		size_t count = 0;
+		while (queue.pop(tid) != nullptr) count++;
+		return count;
+	}
+
+	static size_t receiveMail(MpscQueue<MailMessage>& queue, const int tid) {
+		return queue.drain([](MailMessage* message) { delete message; });
+	}
+
+	//    : producers    durationMs  
+	// (new  ),      .     .
+	template<typename Q>
+	double runMailboxOnce(Q& queue, unsigned producers, unsigned durationMs) {
+		atomic<bool> start(false), running(true);
+		atomic<unsigned> finished(0);
+		unsigned long long received = 0;
+
+		vector<thread> workers;
+		for (unsigned t = 0; t < producers; t++)
+			workers.emplace_back([&, t]() {
+				unsigned long long sent = 0;
+				while (!start.load(memory_order_acquire)) this_thread::yield();
+				while (running.load(memory_order_relaxed))
+					sendMail(queue, new MailMessage(sent++), t);
+				finished.fetch_add(1);
+			});
+		workers.emplace_back([&]() {
+			while (!start.load(memory_order_acquire)) this_thread::yield();
+			while (true) {
+				bool done = finished.load() == producers;
+				size_t count = receiveMail(queue, (int)producers);
+				received += count;
+				if (done && count == 0) break;
+				if (count == 0) this_thread::yield();
+			}
+		});
+
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		this_thread::sleep_for(chrono::milliseconds(durationMs));
+		running.store(false);
+		for (auto& t : workers) t.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		return received / seconds;
+	}
+
+	//  : MSQueue    , DualQueue  
+	static unsigned long long* takeHandoff(MSQueue<unsigned long long>& queue, const int tid) {
+		unsigned long long* item;
+		while ((item = queue.pop(tid)) == nullptr) this_thread::yield();
+		return item;
+	}
+
+	static unsigned long long* takeHandoff(DualQueue<unsigned long long>& queue, const int tid) {
+		return queue.take(tid);
+	}
+
+	//     
+	struct Timer {
+		chrono::steady_clock::time_point due;
+	};
+
+	//    :   timers   , 
+	//  spanMs,   .  DelayQueue (wheel)     ;  MSQueue
+	//          .    ,
+	//  lateness -    ,  rechecks -   .
+	double runDelaysOnce(bool wheel, unsigned long long timers, unsigned spanMs, vector<double>& lateness, double& rechecks) {
+		DelayQueue<Timer> delayed(chrono::microseconds(100), 2);
+		MSQueue<Timer> polled(2);
+		vector<Timer> items(timers);
+		atomic<bool> start(false);
+		unsigned long long returned = 0, early = 0;
+		lateness.clear();
+		lateness.reserve(timers);
+
+		thread consumer([&]() {
+			while (!start.load(memory_order_acquire)) this_thread::yield();
+			unsigned long long received = 0;
+			while (received < timers) {
+				Timer* timer = wheel ? delayed.pop(1) : polled.pop(1);
+				if (timer == nullptr) {
+					this_thread::yield();
+					continue;
+				}
+				auto now = chrono::steady_clock::now();
+				if (now < timer->due) {
+					// DelayQueue     :   - ,     
+					if (wheel) {
+						early++;
+						received++;
+						continue;
+					}
+					polled.push(timer, 1);
+					returned++;
+					continue;
+				}
+				lateness.push_back(chrono::duration<double, milli>(now - timer->due).count());
+				received++;
+			}
+		});
+
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		for (unsigned long long i = 0; i < timers; i++) {
+			//       
+			unsigned long long delayUs = (i * 2654435761ULL) % (spanMs * 1000ULL);
+			items[i].due = chrono::steady_clock::now() + chrono::microseconds(delayUs);
+			if (wheel) delayed.push(&items[i], items[i].due, 0);
+			else polled.push(&items[i], 0);
+		}
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		consumer.join();
+		if (early != 0) throw runtime_error("DelayQueue: " + to_string(early) + " timers delivered before their due time");
+		rechecks = (double)returned / timers;
+		return timers / seconds;
+	}
+
+	//   :      ,     .
+	//     -  .
+	template<typename Q>
+	double runHandoffOnce(unsigned long long exchanges) {
+		Q requests(2), replies(2);
+		unsigned long long request = 0, reply = 0;
+		thread worker([&]() {
+			for (unsigned long long i = 0; i < exchanges; i++) {
+				unsigned long long* item = takeHandoff(requests, 1);
+				reply = *item + 1;
+				replies.push(&reply, 1);
+			}
+		});
+		auto begin = chrono::steady_clock::now();
+		for (unsigned long long i = 0; i < exchanges; i++) {
+			request = i;
+			requests.push(&request, 0);
+			takeHandoff(replies, 0);
+		}
+		double nanoseconds = chrono::duration<double, nano>(chrono::steady_clock::now() - begin).count();
+		worker.join();
+		return nanoseconds / exchanges;
+	}
+
+	//   DualQueue;  ,       
+	struct DualQueueCheck : CacheAligned {
+		DualQueue<unsigned long long> queue;
+		vector<unsigned long long> items;
+		unique_ptr<atomic<unsigned>[]> delivered;
+		unsigned long long marker;
+		atomic<long long> remaining;
+		atomic<unsigned long long> received{ 0 };
+		atomic<unsigned> finished{ 0 }, markers{ 0 }, empty{ 0 };
+
+		DualQueueCheck(int threads, unsigned long long total)
+			: queue(threads), items(total), delivered(new atomic<unsigned>[total]), marker(total), remaining((long long)total) {
+			for (unsigned long long i = 0; i < total; i++) {
+				items[i] = i;
+				delivered[i].store(0, memory_order_relaxed);
+			}
+		}
+
+		// ,    ; true -  takers 
+		bool waitTakers(unsigned takers) {
+			unsigned long long lastReceived = received.load();
+			auto lastProgress = chrono::steady_clock::now();
+			while (finished.load() != takers && chrono::steady_clock::now() - lastProgress < chrono::seconds(1)) {
+				this_thread::sleep_for(chrono::milliseconds(1));
+				if (received.load() != lastReceived) {
+					lastReceived = received.load();
+					lastProgress = chrono::steady_clock::now();
+				}
+			}
+			return finished.load() == takers;
+		}
+	};
+
+	//  DualQueue  : producers    perProducer , takers 
+	//    tryPop  take.        .    push
+	//    ,   ,   ,  
+	//   . ,      (    ),
+	// ,      .
+	static void checkDualQueue(unsigned producers, unsigned takers, unsigned long long perProducer) {
+		const unsigned long long total = producers * perProducer;
+		unique_ptr<DualQueueCheck> state(new DualQueueCheck(producers + takers + 1, total));
+		DualQueueCheck* check = state.get();
+
+		vector<thread> consumers, workers;
+		for (unsigned t = 0; t < takers; t++)
+			consumers.emplace_back([check, producers, t]() {
+				const int tid = (int)(producers + t);
+				for (unsigned long long n = 0; check->remaining.fetch_sub(1) > 0; n++) {
+					unsigned long long* item = n % 2 == 0 ? check->queue.tryPop(tid) : nullptr;
+					if (item == nullptr) item = check->queue.take(tid);
+					if (item == nullptr) check->empty.fetch_add(1);
+					else if (item == &check->marker) check->markers.fetch_add(1);
+					else check->delivered[*item].fetch_add(1);
+					check->received.fetch_add(1);
+				}
+				check->finished.fetch_add(1);
+			});
+		for (unsigned p = 0; p < producers; p++)
+			workers.emplace_back([check, perProducer, p]() {
+				for (unsigned long long i = 0; i < perProducer; i++)
+					check->queue.push(&check->items[p * perProducer + i], (int)p);
+			});
+		for (auto& t : workers) t.join();
+
+		//     : ,    ,   
+		if (!check->waitTakers(takers)) {
+			for (unsigned t = 0; t < takers; t++) check->queue.push(&check->marker, (int)(producers + takers));
+			if (!check->waitTakers(takers)) {
+				for (auto& t : consumers) t.detach();
+				state.release();
+				throw runtime_error("DualQueue: " + to_string(takers - check->finished.load())
+					+ " takers blocked forever on a request dropped from the queue");
+			}
+		}
+		for (auto& t : consumers) t.join();
+
+		unsigned long long lost = 0, duplicated = 0;
+		for (unsigned long long i = 0; i < total; i++) {
+			unsigned count = check->delivered[i].load();
+			if (count == 0) lost++;
+			else if (count > 1) duplicated++;
+		}
+		if (lost != 0 || duplicated != 0 || check->markers.load() != 0 || check->empty.load() != 0)
+			throw runtime_error("DualQueue: " + to_string(lost) + " items lost, " + to_string(duplicated)
+				+ " delivered more than once, take returned nullptr " + to_string(check->empty.load())
+				+ " times of " + to_string(total));
+	}
+
+	//   :    messages ,    
+	//  subscribers :  BroadcastRing (ring)    MSQueue  .
+	//     .
+	double runBroadcastOnce(bool ring, unsigned subscribers, unsigned long long messages) {
+		BroadcastRing<unsigned long long> broadcast(1 << 14);
+		vector<unique_ptr<MSQueue<unsigned long long>>> queues;
+		vector<unsigned long long> payloads(1024);
+		for (unsigned s = 0; s < subscribers; s++) {
+			if (ring) broadcast.subscribe();
+			else queues.emplace_back(new MSQueue<unsigned long long>(subscribers + 1));
+		}
+		atomic<bool> start(false);
+		atomic<unsigned long long> checksum(0);
+
+		vector<thread> workers;
+		for (unsigned s = 0; s < subscribers; s++)
+			workers.emplace_back([&, s]() {
+				unsigned long long received = 0, sum = 0;
+				while (!start.load(memory_order_acquire)) this_thread::yield();
+				while (received < messages) {
+					size_t count = 0;
+					if (ring)
+						count = broadcast.poll((int)s, [&](const unsigned long long& value) { sum += value; });
+					else
+						while (unsigned long long* value = queues[s]->pop((int)s)) {
+							sum += *value;
+							count++;
+						}
+					received += count;
+					if (count == 0) this_thread::yield();
+				}
+				checksum.fetch_add(sum);
+			});
+
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		for (unsigned long long i = 0; i < messages; i++) {
+			if (ring)
+				broadcast.publish(i);
+			else
+				for (auto& queue : queues) queue->push(&payloads[i & 1023], (int)subscribers);
+		}
+		for (auto& t : workers) t.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		return messages / seconds;
+	}
+
+	//      :      push   reserve ,
+	//      nullptr  false,  ,  pop,   push
+	static void checkNodePool(size_t nodes) {
+		MSQueue<int> queue(1);
+		queue.reserve(nodes);
+		queue.setAllocationFree(true);
+		if (queue.getReserved() != nodes) throw runtime_error("MSQueue: reserve did not fill the pool");
+		int value = 0;
+		size_t accepted = 0;
+		while (accepted <= nodes && queue.push(&value, 0)) accepted++;
+		if (accepted != nodes) throw runtime_error("MSQueue: allocation-free push accepted " + to_string(accepted) + " of " + to_string(nodes));
+		if (queue.getReserved() != 0) throw runtime_error("MSQueue: pool not empty after it was exhausted");
+		if (queue.push(nullptr, 0)) throw runtime_error("MSQueue: allocation-free push accepted nullptr");
+		if (queue.pop(0) == nullptr) throw runtime_error("MSQueue: pop from a full pool-backed queue failed");
+		if (!queue.push(&value, 0) || queue.push(&value, 0))
+			throw runtime_error("MSQueue: node released by pop did not return to the pool exactly once");
+		queue.clear();
+		if (queue.getReserved() != nodes) throw runtime_error("MSQueue: pool lost nodes after draining");
+	}
+
+	//      : producers    items ,  
+	//  .  pooled       nodes ,    
+	//   push;      push.    ,
+	//  failures -  push  .
+	double runNodePoolOnce(bool pooled, size_t nodes, unsigned producers, unsigned long long items, double& failures) {
+		MSQueue<unsigned long long> queue(producers + 1);
+		if (pooled) {
+			queue.reserve(nodes);
+			queue.setAllocationFree(true);
+		}
+		vector<unsigned long long> values(items);
+		atomic<bool> start(false);
+		atomic<unsigned long long> refused(0);
+		const unsigned long long total = items * producers;
+
+		thread consumer([&]() {
+			while (!start.load(memory_order_acquire)) this_thread::yield();
+			for (unsigned long long received = 0; received < total; ) {
+				if (queue.pop((int)producers) == nullptr) this_thread::yield();
+				else received++;
+			}
+		});
+
+		vector<thread> workers;
+		for (unsigned p = 0; p < producers; p++)
+			workers.emplace_back([&, p]() {
+				unsigned long long local = 0;
+				while (!start.load(memory_order_acquire)) this_thread::yield();
+				for (unsigned long long i = 0; i < items; i++)
+					while (!queue.push(&values[i], (int)p)) {
+						local++;
+						this_thread::yield();
+					}
+				refused.fetch_add(local);
+			});
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		for (auto& t : workers) t.join();
+		consumer.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		failures = (double)refused.load() / total;
+		return total / seconds;
+	}
+
+	//     : tryPush   capacity ,  pop -  ;
+	//        trackDepth,  size() 
+	static void checkBoundedQueue(size_t capacity) {
+		MSQueue<int> bounded(1, capacity);
+		MSQueue<int> tracked(1, 0, true);
+		MSQueue<int> unbounded(1);
+		int value = 0;
+		size_t accepted = 0;
+		while (accepted <= capacity && bounded.tryPush(&value, 0)) accepted++;
+		if (accepted != capacity) throw runtime_error("MSQueue: tryPush accepted " + to_string(accepted) + " of " + to_string(capacity));
+		if (bounded.size() != capacity) throw runtime_error("MSQueue: size() of a full queue is " + to_string(bounded.size()));
+		bounded.pop(0);
+		if (!bounded.tryPush(&value, 0) || bounded.tryPush(&value, 0))
+			throw runtime_error("MSQueue: tryPush after pop does not take exactly one element");
+		bounded.clear();
+		if (bounded.size() != 0) throw runtime_error("MSQueue: size() of a drained queue is " + to_string(bounded.size()));
+		for (size_t i = 0; i < capacity; i++) tracked.push(&value, 0);
+		if (tracked.size() != capacity) throw runtime_error("MSQueue: size() of a tracked queue is " + to_string(tracked.size()));
+		bool refused = false;
+		try {
+			unbounded.size();
+		}
+		catch (const logic_error&) {
+			refused = true;
+		}
+		if (!refused) throw runtime_error("MSQueue: size() of a queue without depth tracking did not throw");
+	}
+
+	//    : producers    items   pushWait
+	// ( push  capacity == 0),    .     .
+	//    ,  maxDepth -    size(),  .
+	double runBoundedOnce(size_t capacity, unsigned producers, unsigned long long items, size_t& maxDepth) {
+		MSQueue<unsigned long long> queue(producers + 1, capacity, true);
+		vector<unsigned long long> values(items);
+		atomic<bool> start(false);
+		const unsigned long long total = items * producers;
+		maxDepth = 0;
+
+		thread consumer([&]() {
+			while (!start.load(memory_order_acquire)) this_thread::yield();
+			for (unsigned long long received = 0; received < total; ) {
+				if (queue.pop((int)producers) == nullptr) {
+					this_thread::yield();
+					continue;
+				}
+				if (++received % 256 == 0) maxDepth = max(maxDepth, queue.size());
+			}
+		});
+
+		vector<thread> workers;
+		for (unsigned p = 0; p < producers; p++)
+			workers.emplace_back([&, p]() {
+				while (!start.load(memory_order_acquire)) this_thread::yield();
+				for (unsigned long long i = 0; i < items; i++) {
+					if (capacity != 0) queue.pushWait(&values[i], (int)p);
+					else queue.push(&values[i], (int)p);
+				}
+			});
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		for (auto& t : workers) t.join();
+		consumer.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		return total / seconds;
+	}
+
+	//    :        
+	struct StageMessage {
+		unsigned long long value;
+		unsigned long long parsed;
+		unsigned long long transformed;
+	};
+
+	//   : rounds   
+	static unsigned long long stageWork(unsigned long long value, unsigned rounds) {
+		for (unsigned i = 0; i < rounds; i++)
+			value = (value ^ (value >> 31)) * 0x9E3779B97F4A7C15ULL + i;
+		return value;
+	}
+
+	static void showStageStats(const vector<Pipeline<StageMessage>::StageStats>& stats) {
+		cout << "|        |  | . / |   |  |" << endl;
+		for (auto& stage : stats)
+			cout << fixed << setprecision(3) << "| " << left << setw(10) << stage.name << right
+				 << " | " << setw(10) << stage.processed << " | " << setw(16) << stage.throughput / 1e6
+				 << " | " << setw(9) << stage.depth << " | " << setw(6) << stage.capacity << " |" << endl;
+		cout.unsetf(ios::fixed);
+	}
+
+	//   : consumers   takes   QueueSelector    
+	// weights.      takes ,      .
+	//  taken -      .    .
+	double runSelectorOnce(const vector<unsigned>& weights, unsigned consumers, unsigned long long takes,
+		vector<unsigned long long>& taken) {
+		vector<unique_ptr<MSQueue<unsigned long long>>> queues;
+		vector<unsigned long long> values(takes);
+		QueueSelector<unsigned long long> selector;
+		for (size_t q = 0; q < weights.size(); q++) {
+			queues.emplace_back(new MSQueue<unsigned long long>(consumers + 1));
+			for (unsigned long long i = 0; i < takes; i++) queues.back()->push(&values[i], (int)consumers);
+			selector.add(*queues.back(), weights[q]);
+		}
+		unique_ptr<atomic<unsigned long long>[]> counts(new atomic<unsigned long long>[queues.size()]);
+		for (size_t i = 0; i < queues.size(); i++) counts[i].store(0);
+		atomic<long long> remaining((long long)takes);
+		atomic<bool> start(false);
+
+		vector<thread> workers;
+		for (unsigned c = 0; c < consumers; c++)
+			workers.emplace_back([&, c]() {
+				while (!start.load(memory_order_acquire)) this_thread::yield();
+				while (remaining.fetch_sub(1) > 0) {
+					size_t index = 0;
+					selector.select((int)c, &index);
+					counts[index].fetch_add(1, memory_order_relaxed);
+				}
+			});
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		for (auto& t : workers) t.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		taken.clear();
+		for (size_t i = 0; i < queues.size(); i++) taken.push_back(counts[i].load());
+		return takes / seconds;
+	}
+
+#if defined(__unix__) || defined(__APPLE__)
+	//    :       
+	struct SpillRecord {
+		unsigned producer;
+		unsigned long long sequence;
+	};
+
+	struct SpillRecordCodec {
+		size_t size(const SpillRecord*) {
+			return sizeof(SpillRecord);
+		}
+
+		void encode(const SpillRecord* item, char* out) {
+			memcpy(out, item, sizeof(SpillRecord));
+		}
+
+		SpillRecord* decode(const char* data, size_t) {
+			SpillRecord* item = new SpillRecord;
+			memcpy(item, data, sizeof(SpillRecord));
+			return item;
+		}
+	};
+
+	typedef SpillQueue<SpillRecord, SpillRecordCodec> SpillRecordQueue;
+
+	//     fork:      ,     .
+	//    ,           .
+	static bool spillAcrossFork(const string& directory, unsigned producer, int signal, int await) {
+		try {
+			SpillRecordQueue queue(directory, 64, SpillRecordCodec(), 4096, 1);
+			for (unsigned long long i = 0; i < 1024; i++)
+				queue.push(new SpillRecord{ producer, i }, 0);
+			char byte = 0;
+			if (write(signal, &byte, 1) != 1 || read(await, &byte, 1) != 1) return false;
+			bool intact = true;
+			for (unsigned long long i = 0; i < 1024; i++) {
+				SpillRecord* item = queue.pop(0);
+				intact = intact && item != nullptr && item->producer == producer && item->sequence == i;
+				delete item;
+			}
+			return intact;
+		}
+		catch (...) {
+			return false;
+		}
+	}
+
+	//  SpillQueue:  watermark    ,  FIFO ,
+	//     ,   .    
+	//                 .
+	static void checkSpillQueue(const string& directory) {
+		SpillRecordQueue queue(directory, 64, SpillRecordCodec(), 4096, 1);
+		for (unsigned long long i = 0; i < 1024; i++)
+			queue.push(new SpillRecord{ 0, i }, 0);
+		if (!queue.isSpilling() || queue.getSpilledDepth() != 1024 - 64)
+			throw runtime_error("SpillQueue: items above the watermark were not spilled");
+		for (unsigned long long i = 0; i < 1024; i++) {
+			SpillRecord* item = queue.pop(0);
+			bool ordered = item != nullptr && item->sequence == i;
+			delete item;
+			if (!ordered) throw runtime_error("SpillQueue: FIFO order broken");
+		}
+		if (queue.pop(0) != nullptr || queue.isSpilling() || !queue.isEmpty())
+			throw runtime_error("SpillQueue: spill mode still on after draining");
+		queue.push(new SpillRecord{ 0, 0 }, 0);
+		if (queue.getMemoryDepth() != 1 || queue.getSpilledDepth() != 0)
+			throw runtime_error("SpillQueue: push after draining did not go to memory");
+		delete queue.pop(0);
+
+		int toChild[2], toParent[2];
+		if (pipe(toChild) < 0) throw runtime_error("pipe failed");
+		if (pipe(toParent) < 0) {
+			close(toChild[0]);
+			close(toChild[1]);
+			throw runtime_error("pipe failed");
+		}
+		pid_t child = fork();
+		if (child == 0) {
+			//   ,        read  
+			close(toChild[1]);
+			close(toParent[0]);
+			_exit(spillAcrossFork(directory, 2, toParent[1], toChild[0]) ? 0 : 1);
+		}
+		close(toParent[1]);
+		bool intact = child > 0 && spillAcrossFork(directory, 1, toChild[1], toParent[0]);
+		close(toChild[1]);
+		close(toChild[0]);
+		close(toParent[0]);
+		int status = 0;
+		if (child < 0) throw runtime_error("fork failed");
+		waitpid(child, &status, 0);
+		if (!intact || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			throw runtime_error("SpillQueue: processes spilling to one directory overwrote each other's segments");
+	}
+
+	//     : producers    items ,  
+	//    ,       . watermark -  .
+	//    ,  spilled -  ,   .
+	double runSpillOnce(const string& directory, int64_t watermark, unsigned producers, unsigned long long items,
+		double& spilled) {
+		SpillRecordQueue queue(directory, watermark, SpillRecordCodec(), 1 << 20, producers + 1);
+		atomic<bool> start(false);
+		bool ordered = true;
+		const unsigned long long total = items * producers;
+
+		thread consumer([&]() {
+			vector<unsigned long long> next(producers, 0);
+			while (!start.load(memory_order_acquire)) this_thread::yield();
+			for (unsigned long long received = 0; received < total; ) {
+				SpillRecord* item = queue.pop((int)producers);
+				if (item == nullptr) {
+					this_thread::yield();
+					continue;
+				}
+				if (item->sequence != next[item->producer]++) ordered = false;
+				delete item;
+				received++;
+			}
+		});
+
+		vector<thread> workers;
+		for (unsigned p = 0; p < producers; p++)
+			workers.emplace_back([&, p]() {
+				while (!start.load(memory_order_acquire)) this_thread::yield();
+				for (unsigned long long i = 0; i < items; i++)
+					queue.push(new SpillRecord{ p, i }, (int)p);
+			});
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		for (auto& t : workers) t.join();
+		consumer.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		if (!ordered) throw runtime_error("SpillQueue: items of one producer arrived out of order");
+		spilled = (double)queue.getSpilledTotal() / total;
+		return total / seconds;
+	}
+
+	//  ShmQueue:  FIFO,  push   ,   ,
+	//   detach,   recoverDead,     ,    
+	static void checkShmQueue(const string& name) {
+		ShmQueue<unsigned long long>::unlink(name);
+		{
+			ShmQueue<unsigned long long> queue(name, 16);
+			int slot = queue.attach();
+			unsigned long long value;
+			for (unsigned long long i = 0; i < 16; i++)
+				if (!queue.push(i, slot)) throw runtime_error("ShmQueue: push failed before the pool was exhausted");
+			if (queue.push(16, slot)) throw runtime_error("ShmQueue: push succeeded with the pool exhausted");
+			for (unsigned long long i = 0; i < 16; i++)
+				if (!queue.pop(value, slot) || value != i) throw runtime_error("ShmQueue: FIFO order broken");
+			if (queue.pop(value, slot)) throw runtime_error("ShmQueue: pop from an empty queue succeeded");
+
+			pid_t child = fork();
+			if (child < 0) throw runtime_error("fork failed");
+			if (child == 0) {
+				try {
+					ShmQueue<unsigned long long> attached(name);
+					attached.attach();
+				}
+				catch (...) {
+					_exit(1);
+				}
+				_exit(0);
+			}
+			int status = 0;
+			waitpid(child, &status, 0);
+			if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) throw runtime_error("ShmQueue: child could not attach");
+			//     ,      recoverDead
+			vector<int> others;
+			for (int i = 2; i < ShmQueue<unsigned long long>::MAX_PARTICIPANTS; i++) others.push_back(queue.attach());
+			bool full = false;
+			try {
+				queue.attach();
+			}
+			catch (const runtime_error&) {
+				full = true;
+			}
+			if (!full) throw runtime_error("ShmQueue: attach recovered a slot on its own");
+			if (queue.recoverDead() != 1) throw runtime_error("ShmQueue: slot of the exited process was not recovered");
+			others.push_back(queue.attach());
+			for (int other : others) queue.detach(other);
+			queue.detach(slot);
+		}
+		ShmQueue<unsigned long long>::unlink(name);
+
+		//  ""   shm_open:     
+		int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+		if (fd < 0) throw runtime_error("shm_open failed");
+		close(fd);
+		bool timedOut = false;
+		try {
+			ShmQueue<unsigned long long> stale(name, 16, chrono::milliseconds(50));
+		}
+		catch (const runtime_error&) {
+			timedOut = true;
+		}
+		ShmQueue<unsigned long long>::unlink(name);
+		if (!timedOut) throw runtime_error("ShmQueue: attached to an uninitialized segment");
+	}
+
+	//    :        items ,
+	//      .      .
+	//    .
+	double runShmOnce(const string& name, unsigned long long items, uint32_t capacity) {
+		ShmQueue<unsigned long long>::unlink(name);
+		ShmQueue<unsigned long long> queue(name, capacity);
+		int slot = queue.attach();
+		auto begin = chrono::steady_clock::now();
+		pid_t child = fork();
+		if (child < 0) throw runtime_error("fork failed");
+		if (child == 0) {
+			try {
+				ShmQueue<unsigned long long> producer(name);
+				int own = producer.attach();
+				for (unsigned long long i = 0; i < items; i++)
+					while (!producer.push(i, own)) this_thread::yield();
+				producer.detach(own);
+			}
+			catch (...) {
+				_exit(1);
+			}
+			_exit(0);
+		}
+		unsigned long long value, expected = 0;
+		bool ordered = true;
+		while (ordered && expected < items) {
+			if (!queue.pop(value, slot)) {
+				this_thread::yield();
+				continue;
+			}
+			ordered = value == expected++;
+		}
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		if (!ordered) kill(child, SIGKILL);
+		int status = 0;
+		waitpid(child, &status, 0);
+		queue.detach(slot);
+		ShmQueue<unsigned long long>::unlink(name);
+		if (!ordered) throw runtime_error("ShmQueue: FIFO order broken between processes");
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) throw runtime_error("ShmQueue: producer process failed");
+		return items / seconds;
+	}
+#endif
+
+#ifdef __linux__
+	//     ,  
+	static bool fdReady(int fd) {
+		pollfd request = { fd, POLLIN, 0 };
+		return ::poll(&request, 1, 0) > 0 && (request.revents & POLLIN) != 0;
+	}
+
+	//  EventFdNotifier:    push,    drain     push
+	static void checkEventFdNotifier() {
+		MSQueue<int> queue(1);
+		EventFdNotifier notifier;
+		queue.setNotifier(&notifier);
+		int values[3] = { 1, 2, 3 };
+		if (fdReady(notifier.getFd())) throw runtime_error("EventFdNotifier: ready before push");
+		queue.push(&values[0], 0);
+		queue.push(&values[1], 0);
+		if (!fdReady(notifier.getFd())) throw runtime_error("EventFdNotifier: not ready after push");
+		size_t drained = notifier.drain(queue, 0, [](int*) { });
+		if (drained != 2 || fdReady(notifier.getFd())) throw runtime_error("EventFdNotifier: ready after drain");
+		queue.push(&values[2], 0);
+		if (!fdReady(notifier.getFd())) throw runtime_error("EventFdNotifier: not ready after new push");
+		notifier.drain(queue, 0, [](int*) { });
+		queue.setNotifier(nullptr);
+	}
+
+	//    : producers   items   MSQueue,  
+	//  epoll_wait  eventfd     drain.    ,
+	//  wakeups -  .
+	double runEventFdOnce(unsigned producers, unsigned long long items, unsigned long long& wakeups) {
+		MSQueue<unsigned long long> queue(producers + 1);
+		EventFdNotifier notifier;
+		queue.setNotifier(&notifier);
+		vector<unsigned long long> values(items);
+		int ep = epoll_create1(EPOLL_CLOEXEC);
+		if (ep < 0) throw runtime_error("epoll_create1 failed");
+		epoll_event event = {};
+		event.events = EPOLLIN;
+		epoll_ctl(ep, EPOLL_CTL_ADD, notifier.getFd(), &event);
+		atomic<bool> start(false);
+		unsigned long long received = 0;
+		wakeups = 0;
+
+		thread consumer([&]() {
+			while (received < items) {
+				epoll_event ready;
+				if (epoll_wait(ep, &ready, 1, -1) <= 0) continue;
+				wakeups++;
+				received += notifier.drain(queue, (int)producers, [](unsigned long long*) { });
+			}
+		});
+
+		vector<thread> workers;
+		const unsigned long long perProducer = items / producers;
+		for (unsigned p = 0; p < producers; p++)
+			workers.emplace_back([&, p]() {
+				while (!start.load(memory_order_acquire)) this_thread::yield();
+				unsigned long long end = p + 1 == producers ? items : (p + 1) * perProducer;
+				for (unsigned long long i = p * perProducer; i < end; i++)
+					queue.push(&values[i], (int)p);
+			});
+		auto begin = chrono::steady_clock::now();
+		start.store(true, memory_order_release);
+		for (auto& t : workers) t.join();
+		consumer.join();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+		close(ep);
+		queue.setNotifier(nullptr);
+		return items / seconds;
+	}
+#endif
+
+	//  :   2, 4  8  ,  ,      
+	vector<WorkloadResult> runOversubscribed(unsigned durationMs) {
+		unsigned cores = max(thread::hardware_concurrency(), 1u);
+		vector<WorkloadResult> results;
+		for (unsigned noise = 0; noise <= cores; noise += cores)
+			for (unsigned factor = 2; factor <= 8; factor *= 2) {
+				unsigned requested = cores * factor;
+				unsigned threads = requested > MAX_TIDS ? MAX_TIDS : requested;
+				results.push_back(runPairs<MSQueue<int>>("MSQueue", threads, noise, durationMs));
+				results.push_back(runPairs<MutexQueue<int>>("MutexQueue", threads, noise, durationMs));
+				results.push_back(runPairs<TwoLockQueue<int>>("TwoLockQueue", threads, noise, durationMs));
+				//       JSON   
+				if (threads != requested)
+					for (size_t i = results.size() - 3; i < results.size(); i++)
+						results[i].requestedThreads = requested;
+			}
+		return results;
+	}
+
+	static double counterValue(const WorkloadResult& result, const string& name) {
+		for (auto& counter : result.counters)
+			if (counter.first == name) return counter.second;
+		return 0;
+	}
+
+	//    /proc/cpuinfo
+	static string cpuModel() {
+#ifdef __linux__
+		ifstream cpuinfo("/proc/cpuinfo");
+		string line;
+		while (getline(cpuinfo, line))
+			if (line.compare(0, 10, "model name") == 0) {
+				size_t colon = line.find(':');
+				if (colon != string::npos) return line.substr(line.find_first_not_of(' ', colon + 1));
+			}
+#endif
+		return "unknown";
+	}
+
+	static string compilerVersion() {
+#if defined(__clang__)
+		return string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+		return string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+		return "msvc " + to_string(_MSC_FULL_VER);
+#else
+		return "unknown";
+#endif
+	}
+
+	static string jsonString(const string& value) {
+		string escaped = "\"";
+		for (char c : value) {
+			if (c == '"' || c == '\\') escaped += '\\';
+			if ((unsigned char)c < 0x20) escaped += ' ';
+			else escaped += c;
+		}
+		return escaped + "\"";
+	}
+
+	static void writeJsonArray(ostream& out, const vector<double>& values) {
+		out << "[";
+		for (size_t i = 0; i < values.size(); i++)
+			out << (i ? ", " : "") << values[i];
+		out << "]";
+	}
+
+	static void writeJsonPercentiles(ostream& out, const vector<double>& sample) {
+		out << "{\"samples\": " << sample.size()
+			<< ", \"p50\": " << WorkloadResult::percentile(sample, 0.5)
+			<< ", \"p90\": " << WorkloadResult::percentile(sample, 0.9)
+			<< ", \"p99\": " << WorkloadResult::percentile(sample, 0.99)
+			<< ", \"p999\": " << WorkloadResult::percentile(sample, 0.999) << "}";
+	}
+
+public:
+	// maxThreads  MAX_TIDS:       tid     Hazard Pointers
+	QueueBenchmarks(unsigned maxThreads = thread::hardware_concurrency())
+		: maxThreads{ maxThreads > MAX_TIDS ? MAX_TIDS : max(maxThreads, 2u) } { }
+
+	//   JSON: ,  (, ,    )
+	//     -    ,     .
+	//   BenchCompare.
+	void writeJson(ostream& out, const vector<WorkloadResult>& results) {
+		out.imbue(locale::classic());
+		out << setprecision(10);
+		time_t now = time(nullptr);
+		char timestamp[32];
+		strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+		out << "{" << endl;
+		out << "  \"schema\": 1," << endl;
+		out << "  \"timestamp\": " << jsonString(timestamp) << "," << endl;
+		out << "  \"environment\": {\"cpu\": " << jsonString(cpuModel())
+			<< ", \"cores\": " << thread::hardware_concurrency()
+			<< ", \"compiler\": " << jsonString(compilerVersion())
+#ifdef LFQ_BUILD_FLAGS
+			<< ", \"flags\": " << jsonString(LFQ_BUILD_FLAGS)
+#else
+			<< ", \"flags\": \"\""
+#endif
+			<< "}," << endl;
+		out << "  \"config\": {\"items_per_run\": " << itemsPerRun << ", \"repeats\": " << repeats
+			<< ", \"max_threads\": " << maxThreads << ", \"latency_stride\": " << latencyStride << "}," << endl;
+		out << "  \"runs\": [" << endl;
+		for (size_t i = 0; i < results.size(); i++) {
+			const WorkloadResult& result = results[i];
+			out << "    {\"benchmark\": " << jsonString(result.benchmark) << ", \"queue\": " << jsonString(result.queue)
+				<< ", \"writers\": " << result.writers << ", \"readers\": " << result.readers;
+			if (result.requestedThreads != 0) out << ", \"requested_threads\": " << result.requestedThreads;
+			out << "," << endl;
+			out << "     \"throughput\": ";
+			writeJsonArray(out, result.throughput);
+			out << ", \"throughput_median\": " << result.median() << "," << endl;
+			out << "     \"push_latency_ns\": ";
+			writeJsonPercentiles(out, result.pushLatencyNs);
+			out << "," << endl << "     \"pop_latency_ns\": ";
+			writeJsonPercentiles(out, result.popLatencyNs);
+			out << "," << endl << "     \"counters\": {";
+			for (size_t c = 0; c < result.counters.size(); c++)
+				out << (c ? ", " : "") << jsonString(result.counters[c].first) << ": " << result.counters[c].second;
+			out << "}}" << (i + 1 < results.size() ? "," : "") << endl;
+		}
+		out << "  ]" << endl << "}" << endl;
+	}
+
+	//     :      unsigned,  invalid_argument
+	static unsigned parseUnsigned(const string& value) {
+		size_t end = 0;
+		unsigned long parsed = 0;
+		if (!value.empty() && value[0] >= '0' && value[0] <= '9') {
+			try {
+				parsed = stoul(value, &end);
+			}
+			catch (const out_of_range&) {
+				end = 0;
+			}
+		}
+		if (end == 0 || end != value.size() || parsed > numeric_limits<unsigned>::max())
+			throw invalid_argument("expected a non-negative integer, got '" + value + "'");
+		return (unsigned)parsed;
+	}
+
+	//         JSON.
+	// : --json <> [--repeats N] [--items N] [--threads N] [--latency-stride N] [--oversubscribe ]
+	static int runFromArgs(int argc, char* argv[]) {
+		string path;
+		unsigned threads = thread::hardware_concurrency();
+		unsigned repeats = 0, items = 0, stride = 64, oversubscribeMs = 0;
+		for (int i = 1; i < argc; i++) {
+			string arg = argv[i];
+			if (i + 1 >= argc) {
+				cerr << "missing value for " << arg << endl;
+				return 2;
+			}
+			string value = argv[++i];
+			try {
+				if (arg == "--json") path = value;
+				else if (arg == "--repeats") repeats = parseUnsigned(value);
+				else if (arg == "--items") items = parseUnsigned(value);
+				else if (arg == "--threads") {
+					threads = parseUnsigned(value);
+					if (threads < 1 || threads > MAX_TIDS) {
+						cerr << "--threads must be between 1 and " << MAX_TIDS << " (hazard pointer limit)" << endl;
+						return 2;
+					}
+				}
+				else if (arg == "--latency-stride") stride = parseUnsigned(value);
+				else if (arg == "--oversubscribe") oversubscribeMs = parseUnsigned(value);
+				else {
+					cerr << "unknown argument " << arg << endl;
+					return 2;
+				}
+			}
+			catch (const invalid_argument& error) {
+				cerr << arg << ": " << error.what() << endl;
+				return 2;
+			}
+		}
+		if (path.empty()) {
+			cerr << "usage: " << argv[0] << " --json <file> [--repeats N] [--items N] [--threads N] [--latency-stride N]"
+				 << " [--oversubscribe ms]" << endl;
+			return 2;
+		}
+
+		QueueBenchmarks benchmarks(threads);
+		if (repeats != 0) benchmarks.repeats = repeats;
+		if (items != 0) benchmarks.itemsPerRun = items;
+		benchmarks.latencyStride = stride;
+		vector<WorkloadResult> results = benchmarks.runMatrix();
+		if (oversubscribeMs != 0) {
+			vector<WorkloadResult> oversubscribed = benchmarks.runOversubscribed(oversubscribeMs);
+			results.insert(results.end(), oversubscribed.begin(), oversubscribed.end());
+		}
+		ofstream out(path);
+		if (!out) {
+			cerr << "can not open " << path << endl;
+			return 2;
+		}
+		benchmarks.writeJson(out, results);
+		return 0;
+	}
+
+	//  MSQueue  std::mutex + std::queue,   -
+	//     -.   -   
+	//        MSQueue    .
+	void compareBaselines() {
+		showLine();
+		cout << "|    : " << itemsPerRun << " , : " << repeats << endl;
+		cout << "| Mops/s - .   , xN -    MSQueue " << endl;
+		showLine();
+		cout << "|  W |  R |  MSQueue |    mutex |      x |  2-lock |      x | spin-ring |      x |" << endl;
+		showLine();
+		vector<WorkloadResult> results = runMatrix();
+		for (size_t i = 0; i + 3 < results.size(); i += 4) {
+			double ms = results[i].median();
+			double mutex = results[i + 1].median();
+			double twoLock = results[i + 2].median();
+			double ring = results[i + 3].median();
+			cout << fixed << setprecision(2)
+				 << "| " << setw(2) << results[i].writers << " | " << setw(2) << results[i].readers
+				 << " | " << setw(8) << ms / 1e6
+				 << " | " << setw(8) << mutex / 1e6 << " | " << setw(6) << ms / mutex
+				 << " | " << setw(7) << twoLock / 1e6 << " | " << setw(6) << ms / twoLock
+				 << " | " << setw(9) << ring / 1e6 << " | " << setw(6) << ms / ring << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	// :  ,  ,    casNext  casTail  
+	//     .  MSQueue     
+	// ,      push   .
+	void oversubscription(unsigned durationMs = 500) {
+		showLine();
+		cout << "| :  " << thread::hardware_concurrency() << ", " << durationMs
+			 << "   , : " << repeats << endl;
+		cout << "| Jain -   (1 - ), min/max -      " << endl;
+		showLine();
+		cout << "|  |  |         |   Mops/s |  Jain | min/max |   |" << endl;
+		showLine();
+		vector<WorkloadResult> results = runOversubscribed(durationMs);
+		for (auto& result : results)
+			cout << fixed << setprecision(3)
+				 << "| " << setw(7) << result.writers << " | " << setw(3) << (result.benchmark == "oversubscribed" ? 0 : 1)
+				 << " | " << setw(14) << result.queue << " | " << setw(8) << result.median() / 1e6
+				 << " | " << setw(5) << counterValue(result, "fairness_jain")
+				 << " | " << setw(7) << counterValue(result, "min_max_ratio")
+				 << " | " << setw(12) << counterValue(result, "tail_help_rate") * 100 << "% |" << endl;
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	//  :   .
+	//   -  ,     ( )
+	//    (   ,    treeDepth).
+	//  -   submit    ,    .
+	void threadPool(unsigned tasks = 1 << 20, unsigned treeDepth = 20, unsigned latencyTasks = 10000) {
+		ThreadPool pool(maxThreads);
+		atomic<unsigned long long> done(0);
+
+		auto begin = chrono::steady_clock::now();
+		for (unsigned i = 0; i < tasks; i++)
+			pool.submit([&done]() { done.fetch_add(1, memory_order_relaxed); });
+		while (done.load() < tasks) this_thread::yield();
+		double external = tasks / chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+		done.store(0);
+		unsigned long long treeTasks = (2ull << treeDepth) - 1;
+		struct Spawner {
+			// ,       depth
+			ThreadPool& pool;
+			atomic<unsigned long long>& done;
+			unsigned depth;
+			void operator()() const {
+				if (depth > 0) {
+					pool.submit(Spawner{ pool, done, depth - 1 });
+					pool.submit(Spawner{ pool, done, depth - 1 });
+				}
+				done.fetch_add(1, memory_order_relaxed);
+			}
+		};
+		begin = chrono::steady_clock::now();
+		pool.submit(Spawner{ pool, done, treeDepth });
+		while (done.load() < treeTasks) this_thread::yield();
+		double internal = treeTasks / chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+		vector<double> latency(latencyTasks);
+		done.store(0);
+		for (unsigned i = 0; i < latencyTasks; i++) {
+			auto submitted = chrono::steady_clock::now();
+			pool.submit([&latency, &done, i, submitted]() {
+				latency[i] = chrono::duration<double, nano>(chrono::steady_clock::now() - submitted).count();
+				done.fetch_add(1);
+			});
+			while (done.load() <= i) this_thread::yield();
+			this_thread::sleep_for(chrono::microseconds(50));	//   
+		}
+
+		showLine();
+		cout << "|  :  " << pool.size() << endl;
+		showLine();
+		cout << "|  submit: " << external / 1e6 << " . / (" << 1e9 / external << " /)" << endl;
+		cout << "|   : " << internal / 1e6 << " . / (" << 1e9 / internal << " /)" << endl;
+		cout << "|     , : p50 " << WorkloadResult::percentile(latency, 0.5)
+			 << ", p99 " << WorkloadResult::percentile(latency, 0.99)
+			 << ", p99.9 " << WorkloadResult::percentile(latency, 0.999) << endl;
+		showLine();
+	}
+
+	//   MSQueue:  reserve  setAllocationFree   ,    
+	//     256  4096       push;   .
+	void nodePool(unsigned long long items = 1 << 18) {
+		showLine();
+		checkNodePool(1);
+		checkNodePool(1000);
+		unsigned producers = max(maxThreads - 1, 1u);
+		cout << "| MSQueue   :  reserve ,    ,   - ok" << endl;
+		cout << "| : " << producers << ",   : " << items << ", : " << repeats << endl;
+		showLine();
+		cout << "|                  | . / |  push   |" << endl;
+		for (size_t nodes : { (size_t)256, (size_t)4096, (size_t)0 }) {
+			vector<double> rates, refusals;
+			for (unsigned r = 0; r < repeats; r++) {
+				double failures = 0;
+				rates.push_back(runNodePoolOnce(nodes != 0, nodes, producers, items, failures));
+				refusals.push_back(failures);
+			}
+			cout << fixed << setprecision(3) << "| " << left
+				 << setw(20) << (nodes != 0 ? " " + to_string(nodes) : string("new   push")) << right
+				 << " | " << setw(16) << WorkloadResult::percentile(rates, 0.5) / 1e6
+				 << " | " << setw(23) << WorkloadResult::percentile(refusals, 0.5) << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	//  :  tryPush   ,    pushWait   
+	//   64, 1024   .        ,
+	//    ;   .
+	void boundedQueue(unsigned long long items = 1 << 18) {
+		showLine();
+		checkBoundedQueue(100);
+		checkBoundedQueue(5000);
+		unsigned producers = max(maxThreads - 1, 1u);
+		cout << "| MSQueue  : tryPush   capacity  - ok" << endl;
+		cout << "| : " << producers << ",   : " << items << ", : " << repeats << endl;
+		showLine();
+		cout << "|  | . / |   |" << endl;
+		for (size_t capacity : { (size_t)64, (size_t)1024, (size_t)0 }) {
+			vector<double> rates;
+			size_t deepest = 0;
+			for (unsigned r = 0; r < repeats; r++) {
+				size_t maxDepth = 0;
+				rates.push_back(runBoundedOnce(capacity, producers, items, maxDepth));
+				deepest = max(deepest, maxDepth);
+			}
+			if (capacity != 0 && deepest > capacity + producers)
+				throw runtime_error("MSQueue: depth " + to_string(deepest) + " exceeds capacity " + to_string(capacity));
+			cout << fixed << setprecision(3) << "| " << setw(7) << (capacity != 0 ? to_string(capacity) : string(""))
+				 << " | " << setw(16) << WorkloadResult::percentile(rates, 0.5) / 1e6
+				 << " | " << setw(18) << deepest << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	//  parse -> transform -> serialize,       .
+	// stats()     :       .
+	//        ,    -    .
+	void pipeline(unsigned long long items = 1 << 18) {
+		showLine();
+		unsigned workers = max(maxThreads / 2, 1u);
+		cout << "| : " << items << " ,    transform: " << workers << endl;
+		showLine();
+		vector<StageMessage> messages(items);
+		unsigned long long expected = 0;
+		for (unsigned long long i = 0; i < items; i++) {
+			messages[i].value = i;
+			expected += stageWork(stageWork(i, 8), 16) + stageWork(i, 64);
+		}
+		atomic<unsigned long long> checksum(0);
+		Pipeline<StageMessage> pipeline;
+		pipeline.stage("parse", [](vector<StageMessage*>& batch) {
+				for (StageMessage* message : batch) message->parsed = stageWork(message->value, 8);
+			}, 1, 16, 256)
+			.stage("transform", [](vector<StageMessage*>& batch) {
+				for (StageMessage* message : batch) message->transformed = stageWork(message->parsed, 16);
+			}, workers, 16, 256)
+			.stage("serialize", [&checksum](vector<StageMessage*>& batch) {
+				unsigned long long sum = 0;
+				for (StageMessage* message : batch) sum += message->transformed + stageWork(message->value, 64);
+				checksum.fetch_add(sum, memory_order_relaxed);
+			}, 1, 64, 256);
+		pipeline.start();
+		for (unsigned long long i = 0; i < items; i++) {
+			pipeline.push(&messages[i]);
+			if (i == items / 2) {
+				cout << "|  :" << endl;
+				showStageStats(pipeline.stats());
+			}
+		}
+		vector<Pipeline<StageMessage>::StageStats> stats;
+		do {
+			this_thread::yield();
+			stats = pipeline.stats();
+		} while (stats.back().processed < items);
+		pipeline.finish();
+		cout << "|  :" << endl;
+		showStageStats(stats);
+		for (auto& stage : stats)
+			if (stage.processed != items)
+				throw runtime_error("Pipeline: stage " + stage.name + " processed " + to_string(stage.processed));
+		if (checksum.load() != expected) throw runtime_error("Pipeline: checksum mismatch");
+		showLine();
+	}
+
+	//    : QueueSelector   1:3, 1:2:4  1:1:1:1,   .
+	//         ;  - .
+	void queueSelector(unsigned long long takes = 1 << 20) {
+		showLine();
+		unsigned consumers = max(maxThreads / 2, 1u);
+		cout << "|   : " << takes << " , : " << consumers << endl;
+		showLine();
+		cout << "|        |                     | . / |" << endl;
+		vector<vector<unsigned>> weightSets = { { 1, 3 }, { 1, 2, 4 }, { 1, 1, 1, 1 } };
+		for (auto& weights : weightSets) {
+			unsigned total = 0;
+			for (unsigned weight : weights) total += weight;
+			unsigned long long rounded = takes / total * total;
+			vector<unsigned long long> taken;
+			double rate = runSelectorOnce(weights, consumers, rounded, taken);
+			string weightText, takenText;
+			for (size_t i = 0; i < weights.size(); i++) {
+				weightText += (i ? ":" : "") + to_string(weights[i]);
+				takenText += (i ? " " : "") + to_string(taken[i]);
+				if (taken[i] != rounded / total * weights[i])
+					throw runtime_error("QueueSelector: weight " + to_string(weights[i]) + " got " + to_string(taken[i])
+						+ " of " + to_string(rounded));
+			}
+			cout << fixed << setprecision(3) << "| " << left << setw(10) << weightText << " | " << setw(34) << takenText
+				 << right << " | " << setw(14) << rate / 1e6 << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+#if defined(__unix__) || defined(__APPLE__)
+	//     :    ,     
+	//    ;   .     ,
+	//      .
+	void spillQueue(unsigned long long items = 1 << 18) {
+		showLine();
+		char pattern[] = "/tmp/lfq-spill-XXXXXX";
+		if (mkdtemp(pattern) == nullptr) throw runtime_error("mkdtemp failed");
+		const string directory = pattern;
+		checkSpillQueue(directory);
+		unsigned producers = max(maxThreads - 1, 1u);
+		cout << "| SpillQueue:   watermark, FIFO,      - ok" << endl;
+		cout << "| : " << producers << ",   : " << items << ", : " << repeats << endl;
+		showLine();
+		cout << "| Watermark  | . / |    |" << endl;
+		for (int64_t watermark : { (int64_t)1 << 40, (int64_t)4096, (int64_t)256 }) {
+			vector<double> rates, shares;
+			for (unsigned r = 0; r < repeats; r++) {
+				double spilled = 0;
+				rates.push_back(runSpillOnce(directory, watermark, producers, items, spilled));
+				shares.push_back(spilled);
+			}
+			cout << fixed << setprecision(3) << "| " << setw(10) << (watermark > 1 << 30 ? string("") : to_string(watermark))
+				 << " | " << setw(16) << WorkloadResult::percentile(rates, 0.5) / 1e6
+				 << " | " << setw(13) << WorkloadResult::percentile(shares, 0.5) << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		if (rmdir(directory.c_str()) != 0) throw runtime_error("SpillQueue: segments left in " + directory);
+		showLine();
+	}
+
+	//   ShmQueue:    ,     
+	//     64, 1024  16384 ;   .
+	void sharedMemoryQueue(unsigned long long items = 1 << 20) {
+		showLine();
+		const string name = "/lfq_bench_" + to_string((long long)getpid());
+		checkShmQueue(name);
+		cout << "| ShmQueue: FIFO,    ,  ,    - ok" << endl;
+		cout << "|  : " << items << "   , : " << repeats << endl;
+		showLine();
+		cout << "|    | . / |" << endl;
+		for (uint32_t capacity : { 64u, 1024u, 16384u }) {
+			vector<double> rates;
+			for (unsigned r = 0; r < repeats; r++)
+				rates.push_back(runShmOnce(name, items, capacity));
+			cout << fixed << setprecision(3) << "| " << setw(12) << capacity << " | "
+				 << setw(16) << WorkloadResult::percentile(rates, 0.5) / 1e6 << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+#endif
+
+#ifdef __linux__
+	//   eventfd:   ,     
+	//  epoll_wait  1, 2, 4, ... ;   .
+	void eventFdNotifier(unsigned long long items = 1 << 20) {
+		showLine();
+		checkEventFdNotifier();
+		cout << "| EventFdNotifier:   push,    drain,    push - ok" << endl;
+		cout << "|  : " << items << "   , : " << repeats << endl;
+		showLine();
+		cout << "|  | . / |    |" << endl;
+		for (unsigned producers = 1; producers < max(maxThreads, 2u); producers *= 2) {
+			vector<double> rates, batches;
+			for (unsigned r = 0; r < repeats; r++) {
+				unsigned long long wakeups = 0;
+				rates.push_back(runEventFdOnce(producers, items, wakeups));
+				batches.push_back((double)items / wakeups);
+			}
+			cout << fixed << setprecision(3)
+				 << "| " << setw(14) << producers << " | " << setw(16) << WorkloadResult::percentile(rates, 0.5) / 1e6
+				 << " | " << setw(24) << WorkloadResult::percentile(batches, 0.5) << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+#endif
+
+	//  : DelayQueue     MSQueue    .
+	//  ,  ,    spanMs.
+	void delays(unsigned long long timers = 1 << 18, unsigned spanMs = 200) {
+		showLine();
+		cout << "|  : " << timers << "    " << spanMs << " " << endl;
+		showLine();
+		cout << "|     | , ./ |  p50,  |  p99,  |    |" << endl;
+		for (bool wheel : { true, false }) {
+			vector<double> lateness;
+			double rechecks = 0;
+			double rate = runDelaysOnce(wheel, timers, spanMs, lateness, rechecks);
+			cout << fixed << setprecision(3)
+				 << "| " << (wheel ? "DelayQueue" : "MSQueue   ") << " | " << setw(15) << rate / 1e6
+				 << " | " << setw(17) << WorkloadResult::percentile(lateness, 0.5)
+				 << " | " << setw(17) << WorkloadResult::percentile(lateness, 0.99)
+				 << " | " << setw(19) << rechecks << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	//   :   -   . MSQueue  
+	//  DualQueue,     ;   .
+	void handoff(unsigned long long exchanges = 100000) {
+		showLine();
+		cout << "|  : " << exchanges << "   , : " << repeats << endl;
+		showLine();
+		for (unsigned r = 0; r < repeats; r++) checkDualQueue(4, 6, 24000);
+		cout << "| DualQueue:       (4 , 6 )" << endl;
+		vector<double> polling, dual;
+		for (unsigned r = 0; r < repeats; r++) {
+			polling.push_back(runHandoffOnce<MSQueue<unsigned long long>>(exchanges));
+			dual.push_back(runHandoffOnce<DualQueue<unsigned long long>>(exchanges));
+		}
+		cout << fixed << setprecision(1)
+			 << "| MSQueue  , /: " << WorkloadResult::percentile(polling, 0.5) << endl
+			 << "| DualQueue, /: " << WorkloadResult::percentile(dual, 0.5) << endl;
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	// :  ,     . BroadcastRing 
+	//  MSQueue    1, 2, 4, ... ;   .
+	void broadcast(unsigned long long messages = 1 << 20) {
+		showLine();
+		cout << "| :  , " << messages << "   , : " << repeats << endl;
+		showLine();
+		cout << "|  | BroadcastRing, . ./ | MSQueue  , . ./ |" << endl;
+		for (unsigned subscribers = 1; subscribers < max(maxThreads, 2u); subscribers *= 2) {
+			vector<double> ring, queues;
+			for (unsigned r = 0; r < repeats; r++) {
+				ring.push_back(runBroadcastOnce(true, subscribers, messages));
+				queues.push_back(runBroadcastOnce(false, subscribers, messages));
+			}
+			cout << fixed << setprecision(3)
+				 << "| " << setw(11) << subscribers << " | " << setw(28) << WorkloadResult::percentile(ring, 0.5) / 1e6
+				 << " | " << setw(36) << WorkloadResult::percentile(queues, 0.5) / 1e6 << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	//  :  ,  . MSQueue   IntrusiveQueue
+	//  MpscQueue   1, 2, 4, ... ;   .
+	void mailboxes(unsigned durationMs = 300) {
+		showLine();
+		cout << "|  :  , " << durationMs << "   , : " << repeats << endl;
+		showLine();
+		cout << "|  | MSQueue, . ./ | IntrusiveQueue, . ./ | MpscQueue, . ./ |" << endl;
+		for (unsigned producers = 1; producers < max(maxThreads, 2u); producers *= 2) {
+			vector<double> general, intrusive, mpsc;
+			for (unsigned r = 0; r < repeats; r++) {
+				{
+					MSQueue<MailMessage> queue(producers + 1);
+					general.push_back(runMailboxOnce(queue, producers, durationMs));
+				}
+				{
+					IntrusiveQueue<MailMessage> queue(producers + 1);
+					intrusive.push_back(runMailboxOnce(queue, producers, durationMs));
+				}
+				{
+					MpscQueue<MailMessage> queue;
+					mpsc.push_back(runMailboxOnce(queue, producers, durationMs));
+				}
+			}
+			cout << fixed << setprecision(3)
+				 << "| " << setw(14) << producers << " | " << setw(22) << WorkloadResult::percentile(general, 0.5) / 1e6
+				 << " | " << setw(29) << WorkloadResult::percentile(intrusive, 0.5) / 1e6
+				 << " | " << setw(24) << WorkloadResult::percentile(mpsc, 0.5) / 1e6 << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	//  : ByteRing  MSQueue    , 1, 2, 4, ... 
+	//   ,   16, 64  512 .
+	void byteMessages(unsigned durationMs = 300) {
+		showLine();
+		cout << "|  :  , " << durationMs << "   , : " << repeats << endl;
+		showLine();
+		cout << "|  |  | ByteRing, . ./ | MSQueue + new[], . ./ |" << endl;
+		for (unsigned producers = 1; producers < max(maxThreads, 2u); producers *= 2)
+			for (unsigned messageSize : { 16u, 64u, 512u }) {
+				double ring = runByteMessages(true, producers, messageSize, durationMs);
+				double pointers = runByteMessages(false, producers, messageSize, durationMs);
+				cout << fixed << setprecision(3)
+					 << "| " << setw(14) << producers << " | " << setw(4) << messageSize
+					 << " | " << setw(23) << ring / 1e6 << " | " << setw(30) << pointers / 1e6 << " |" << endl;
+			}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	//   : SkipListPriorityQueue    ,  push/pop
+	//  1, 2, 4, ... maxThreads .      PriorityLaneQueue  64 .
+	void priorityQueues(unsigned durationMs = 300, unsigned keyRange = 1 << 20, unsigned prefill = 1 << 12) {
+		showLine();
+		cout << "|   :  [0, " << keyRange << "),   " << prefill << " , "
+			 << durationMs << "   , : " << repeats << endl;
+		showLine();
+		cout << "|  | SkipListPriorityQueue, Mops/s | MutexHeapQueue, Mops/s |" << endl;
+		for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+			double skipList = runPriorityPairs<SkipListPriorityQueue<unsigned, int>>(threads, keyRange, prefill, durationMs);
+			double heap = runPriorityPairs<MutexHeapQueue<unsigned, int>>(threads, keyRange, prefill, durationMs);
+			cout << fixed << setprecision(3)
+				 << "| " << setw(7) << threads << " | " << setw(29) << skipList / 1e6
+				 << " | " << setw(22) << heap / 1e6 << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+		const unsigned levels = 64;
+		cout << "|  : " << levels << endl;
+		showLine();
+		cout << "|  | PriorityLaneQueue, Mops/s | SkipListPriorityQueue, Mops/s | MutexHeapQueue, Mops/s |" << endl;
+		for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+			double lanes = runPriorityPairs<PriorityLaneQueue<int>>(threads, levels, prefill, durationMs);
+			double skipList = runPriorityPairs<SkipListPriorityQueue<unsigned, int>>(threads, levels, prefill, durationMs);
+			double heap = runPriorityPairs<MutexHeapQueue<unsigned, int>>(threads, levels, prefill, durationMs);
+			cout << fixed << setprecision(3)
+				 << "| " << setw(7) << threads << " | " << setw(25) << lanes / 1e6
+				 << " | " << setw(29) << skipList / 1e6
+				 << " | " << setw(22) << heap / 1e6 << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	// -: LockFreeHashMap  ShardedMutexMap     (90% find)
+	//       (50% find), 1, 2, 4, ... maxThreads .
+	void hashMap(unsigned durationMs = 300, unsigned keyRange = 1 << 16) {
+		showLine();
+		cout << "| -:  " << keyRange << ", " << durationMs << "   , : " << repeats << endl;
+		showLine();
+		cout << "|  | find, % | LockFreeHashMap, Mops/s | ShardedMutexMap, Mops/s |" << endl;
+		const unsigned mixes[] = { 90, 50 };
+		for (unsigned findPercent : mixes)
+			for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+				double lockFree = runMapMix<LockFreeHashMap<unsigned long long, unsigned long long>>(threads, findPercent, keyRange, durationMs);
+				double sharded = runMapMix<ShardedMutexMap<unsigned long long, unsigned long long>>(threads, findPercent, keyRange, durationMs);
+				cout << fixed << setprecision(3)
+					 << "| " << setw(7) << threads << " | " << setw(7) << findPercent
+					 << " | " << setw(23) << lockFree / 1e6 << " | " << setw(23) << sharded / 1e6 << " |" << endl;
+			}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	//  :  push/pop  1, 2, 4, ... maxThreads       .
+	//  retired_nodes ,  ,    ,  .
+	void stackElimination(unsigned durationMs = 300) {
+		showLine();
+		cout << "|  :  push/pop, " << durationMs << "   , : " << repeats << endl;
+		showLine();
+		cout << "|  |  , Mops/s |  , Mops/s |" << endl;
+		for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+			WorkloadResult eliminating = runPairs<TreiberStack<int>>("TreiberStack", threads, 0, durationMs);
+			WorkloadResult plain = runPairs<PlainTreiberStack>("TreiberStack-plain", threads, 0, durationMs);
+			cout << fixed << setprecision(3)
+				 << "| " << setw(7) << threads << " | " << setw(21) << eliminating.median() / 1e6
+				 << " | " << setw(22) << plain.median() / 1e6 << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	//  :     treeDepth   Chase-Lev     MSQueue.
+	//       .
+	void workStealing(unsigned treeDepth = 18) {
+		showLine();
+		cout << "|  :    " << treeDepth << " (" << ((2ull << treeDepth) - 1) << " ), : " << repeats << endl;
+		showLine();
+		cout << "|  | Chase-Lev, . / |  |  MSQueue, . / |" << endl;
+		for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+			vector<double> stealing, shared;
+			unsigned long long steals = 0;
+			for (unsigned r = 0; r < repeats; r++) {
+				stealing.push_back(runStealingTree(threads, treeDepth, steals));
+				shared.push_back(runSharedQueueTree(threads, treeDepth));
+			}
+			cout << fixed << setprecision(3)
+				 << "| " << setw(7) << threads << " | " << setw(23) << WorkloadResult::percentile(stealing, 0.5) / 1e6
+				 << " | " << setw(4) << steals << " | " << setw(27) << WorkloadResult::percentile(shared, 0.5) / 1e6 << " |" << endl;
+		}
+		cout.unsetf(ios::fixed);
+		showLine();
+	}
+
+	//   MSQueue:    ,   N  ,
+	//    ,  RSS        .
+	//  RSS   /proc/self/status     Linux.
+	void memoryFootprint(unsigned emptyQueues = 256, unsigned liveItems = 1 << 20, unsigned sampleMs = 1) {
+		showLine();
+		cout << "|  MSQueue<int>" << endl;
+		cout << "|  : " << MSQueue<int>::getNodeSize() << " " << endl;
+		cout << "|     (): " << MSQueue<int>::getFixedFootprint() << " " << endl;
+		showLine();
+
+		//  N  
+		vector<MSQueue<int>*> queues(emptyQueues);
+		size_t rssBefore = readProcStatus("VmRSS");
+		auto begin = chrono::steady_clock::now();
+		for (auto& queue : queues)
+			queue = new MSQueue<int>(maxThreads);
+		double createUs = chrono::duration<double, micro>(chrono::steady_clock::now() - begin).count();
+		size_t rssAfter = readProcStatus("VmRSS");
+		begin = chrono::steady_clock::now();
+		for (auto queue : queues)
+			delete queue;
+		double destroyUs = chrono::duration<double, micro>(chrono::steady_clock::now() - begin).count();
+		cout << "|  : " << emptyQueues << endl;
+		cout << "| : " << createUs / emptyQueues << " /, : " << destroyUs / emptyQueues << " /" << endl;
+		if (rssAfter != 0)
+			cout << "|  RSS: " << (rssAfter - rssBefore) * 1024.0 / emptyQueues << " /" << endl;
+		showLine();
+
+		//    :    liveItems       ,
+		//   RSS    
+		{
+			MSQueue<int> queue(1);
+			int item = 0;
+			rssBefore = readProcStatus("VmRSS");
+			for (unsigned i = 0; i < liveItems; i++)
+				queue.push(&item, 0);
+			rssAfter = readProcStatus("VmRSS");
+			cout << "|  : " << liveItems << endl;
+			if (rssAfter != 0)
+				cout << "|  RSS: " << (rssAfter - rssBefore) * 1024.0 / liveItems << " /" << endl;
+		}
+		showLine();
+
+		//   (retired)    
+		unsigned writers = maxThreads / 2, readers = maxThreads - maxThreads / 2;
+		MSQueue<int> queue(writers + readers);
+		vector<pair<double, size_t>> series;
+		atomic<bool> running(true);
+		thread sampler([&]() {
+			auto start = chrono::steady_clock::now();
+			while (running.load()) {
+				double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+				series.push_back(make_pair(ms, queue.getRetiredCount()));
+				this_thread::sleep_for(chrono::milliseconds(sampleMs));
+			}
+		});
+		double throughput = runTransferOnce(queue, writers, readers);
+		running.store(false);
+		sampler.join();
+
+		size_t peak = 0;
+		for (auto& sample : series)
+			peak = max(peak, sample.second);
+		cout << "|  , : " << writers << ", : " << readers
+			 << ", " << throughput / 1e6 << " Mops/s" << endl;
+		cout << "| : " << peak << "  (" << peak * MSQueue<int>::getNodeSize() << " )" << endl;
+		cout << "|    t,  | " << endl;
+		size_t step = max<size_t>(series.size() / 20, 1);
+		for (size_t i = 0; i < series.size(); i += step)
+			cout << "| " << setw(8) << fixed << setprecision(1) << series[i].first << " | " << series[i].second << endl;
+		cout.unsetf(ios::fixed);
+		cout << "|  RSS : " << readProcStatus("VmHWM") << " " << endl;
+		showLine();
+	}
+
+#ifdef MSQUEUE_TEST_HOOKS
+	//    :     push/pop,   0   
+	// onPopProtected   pop  stallMs,  Hazard Pointers     .
+	//  sampleMs         .
+	//  Hazard Pointers         .
+	void stalledThread(unsigned durationMs = 3000, unsigned stallAtMs = 1000, unsigned stallMs = 1000, unsigned sampleMs = 100) {
+		const unsigned threads = maxThreads;
+		const unsigned victim = 0;
+		const unsigned pad = 128 / sizeof(atomic<unsigned long long>);	//    -
+		MSQueue<int> queue(threads);
+		unique_ptr<atomic<unsigned long long>[]> ops(new atomic<unsigned long long>[threads * pad]);
+		for (unsigned i = 0; i < threads; i++)
+			ops[i * pad].store(0);
+		atomic<bool> stallRequested(false), stalled(false), running(true);
+		int item = 0;
+
+		queue.onPopProtected = [&](const int tid) {
+			if (tid == (int)victim && stallRequested.exchange(false)) {
+				stalled.store(true);
+				this_thread::sleep_for(chrono::milliseconds(stallMs));
+				stalled.store(false);
+			}
+		};
+
+		vector<thread> workers;
+		for (unsigned t = 0; t < threads; t++)
+			workers.emplace_back([&, t]() {
+				while (running.load(memory_order_relaxed)) {
+					queue.push(&item, t);
+					queue.pop(t);
+					ops[t * pad].store(ops[t * pad].load(memory_order_relaxed) + 1, memory_order_relaxed);
+				}
+			});
+
+		showLine();
+		cout << "|  :  " << threads << ",  " << victim << "   "
+			 << stallMs << "   pop" << endl;
+		showLine();
+		cout << "|    t,  |  | Mops/s () |  " << endl;
+		auto begin = chrono::steady_clock::now();
+		unsigned long long lastOps = 0;
+		size_t peakRetired = 0;
+		for (unsigned elapsed = sampleMs; elapsed <= durationMs; elapsed += sampleMs) {
+			if (elapsed > stallAtMs && elapsed <= stallAtMs + sampleMs)
+				stallRequested.store(true);
+			this_thread::sleep_until(begin + chrono::milliseconds(elapsed));
+			unsigned long long totalOps = 0;
+			for (unsigned t = 0; t < threads; t++)
+				if (t != victim) totalOps += ops[t * pad].load(memory_order_relaxed);
+			size_t retired = queue.getRetiredCount();
+			peakRetired = max(peakRetired, retired);
+			cout << "| " << setw(8) << elapsed << " | " << setw(10) << (stalled.load() ? "" : "")
+				 << " | " << setw(18) << fixed << setprecision(2) << (totalOps - lastOps) / (sampleMs * 1e3)
+				 << " | " << retired << endl;
+			lastOps = totalOps;
+		}
+		cout.unsetf(ios::fixed);
+		running.store(false);
+		for (auto& t : workers) t.join();
+		queue.onPopProtected = nullptr;
+		cout << "|   : " << peakRetired << endl;
+		showLine();
+	}
+#endif
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,18 @@
+#ifndef _QUEUE_NOTIFIER_H_
+#define _QUEUE_NOTIFIER_H_
+
+
+class QueueNotifier {
+    /*
+    //      .   MSQueue  setNotifier().
+    // notify()   push  ,     ( ),
+    //  ,      ,   .
+    //      ,    .
+    */
+public:
+    virtual ~QueueNotifier() { }
+
+    virtual void notify() = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+#ifndef _QUEUE_SELECTOR_H_
+#define _QUEUE_SELECTOR_H_
+
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+#include "MSQueue.hpp"
+#include "QueueNotifier.hpp"
+#include "EventCount.hpp"
+
+
+template<typename T>
+class QueueSelector : public QueueNotifier {
+    /*
+    //        MSQueue.
+    //       QueueNotifier,    
+    //     EventCount,       .
+    //     , push    .
+    //
+    //       :    w  w
+    //    ,   (smooth weighted round-robin).   
+    //         ,    ,
+    //        ,    
+    //      .   1 -   .
+    //       :   *   .
+    //
+    //      .       :
+    // add  ,       EventFdNotifier  .
+    */
+private:
+    std::vector<MSQueue<T>*> queues;
+    std::vector<unsigned> weights;
+    std::vector<unsigned> scan;             //    -     
+    alignas(128) std::atomic<unsigned> cursor{ 0 };
+    std::atomic<bool> closed{ false };
+    EventCount event;
+
+    //  smooth weighted round-robin:         .
+    //         ,    
+    //   scan.
+    void buildOrder() {
+        unsigned total = 0;
+        for (unsigned weight : weights) total += weight;
+        std::vector<long> current(weights.size(), 0);
+        std::vector<unsigned> order;
+        for (unsigned step = 0; step < total; step++) {
+            size_t best = 0;
+            for (size_t i = 0; i < weights.size(); i++) {
+                current[i] += weights[i];
+                if (current[i] > current[best]) best = i;
+            }
+            current[best] -= total;
+            order.push_back((unsigned)best);
+        }
+        scan.clear();
+        std::vector<unsigned> seen(weights.size(), 0);
+        for (unsigned pos = 0; pos < total; pos++)
+            for (unsigned i = 0; i < total; i++) {
+                unsigned iqueue = order[(pos + i) % total];
+                if (seen[iqueue] == pos + 1) continue;
+                seen[iqueue] = pos + 1;
+                scan.push_back(iqueue);
+            }
+    }
+
+public:
+    QueueSelector() { }
+
+    ~QueueSelector() {
+        for (auto queue : queues)
+            queue->setNotifier(nullptr);
+    }
+
+    QueueSelector(const QueueSelector&) = delete;
+    QueueSelector& operator=(const QueueSelector&) = delete;
+
+    //     weight.     .
+    size_t add(MSQueue<T>& queue, unsigned weight = 1) {
+        if (weight == 0) throw std::invalid_argument("weight can not be 0");
+        queues.push_back(&queue);
+        weights.push_back(weight);
+        buildOrder();
+        queue.setNotifier(this);
+        return queues.size() - 1;
+    }
+
+    void notify() override {
+        event.notifyOne();
+    }
+
+    //  :       nullptr.
+    //  index   ,    .
+    T* trySelect(const int tid, size_t* index = nullptr) {
+        if (queues.empty()) return nullptr;
+        const size_t count = queues.size();
+        const unsigned* positions = &scan[cursor.fetch_add(1, std::memory_order_relaxed) % (scan.size() / count) * count];
+        for (size_t i = 0; i < count; i++) {
+            size_t iqueue = positions[i];
+            T* item = queues[iqueue]->pop(tid);
+            if (item != nullptr) {
+                if (index != nullptr) *index = iqueue;
+                return item;
+            }
+        }
+        return nullptr;
+    }
+
+    //  :      .  nullptr   close().
+    T* select(const int tid, size_t* index = nullptr) {
+        while (true) {
+            T* item = trySelect(tid, index);
+            if (item != nullptr) return item;
+            if (closed.load()) return nullptr;
+            uint64_t key = event.prepareWait();
+            //     : push,   prepareWait,
+            //    
+            item = trySelect(tid, index);
+            if (item != nullptr || closed.load()) {
+                event.cancelWait();
+                if (item != nullptr) return item;
+                return nullptr;
+            }
+            event.wait(key);
+        }
+    }
+
+    //   ; select  nullptr,   
+    void close() {
+        closed.store(true);
+        event.notifyAll();
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,402 @@
+#ifndef _SHM_QUEUE_H_
+#define _SHM_QUEUE_H_
+
+//  POSIX: shm_open(3), mmap(2)
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+template<typename T>
+class ShmQueue {
+    /*
+    //   -     (shm_open + mmap).
+    //     : ,       .
+    //        ,   Node* 
+    //  -     (0 -  ).    , T -  .
+    //
+    //            32   (  ABA).
+    //         Hazard Pointers:    
+    //      ,  ,  attach   pid 
+    //     PID.
+    //        recoverDead:  ,
+    //       ,     .
+    //   ,  kill(pid, 0)  ESRCH.      
+    //  PID:      (   /dev/shm) recoverDead  ,
+    //    detach. ,       ,   
+    //  , .
+    //
+    //      : push  pop -     .
+    //      ;   -  attach.
+    //
+    //     ShmQueue<Message> queue("/orders", 4096);     //      
+    //     int slot = queue.attach();
+    //     queue.push(message, slot);
+    //     ...
+    //     queue.detach(slot);
+    //
+    //   ,    ,     initTimeout  
+    // std::runtime_error.      ;    unlink.
+    */
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "shared memory requires lock-free atomics");
+
+public:
+    static const int MAX_PARTICIPANTS = 64;
+
+private:
+    static const uint64_t MAGIC = 0x4D5351534D485132ull;
+    static const int HPS = 2;
+    static const uint32_t RETIRED_MAX = MAX_PARTICIPANTS * HPS + 1;    // , ..  scan   
+    static const int32_t RECOVERING = -1;                               // pid ,  
+    static const uint64_t UNKNOWN_NAMESPACE = 0;                        //  ,     
+
+    struct Node {
+        std::atomic<uint32_t> next;     //        
+        T item;
+    };
+
+    struct alignas(128) Slot {
+        std::atomic<int32_t> pid;               // 0 -  
+        std::atomic<uint64_t> pidNamespace;     //   PID ,   pid  
+        std::atomic<uint32_t> hazard[HPS];
+        std::atomic<uint32_t> retiredCount;     //    
+        std::atomic<uint32_t> retired[RETIRED_MAX];
+    };
+
+    struct Header {
+        std::atomic<uint64_t> magic;            //  ,   
+        uint32_t capacity;
+        uint32_t itemSize;
+        alignas(128) std::atomic<uint32_t> head;
+        alignas(128) std::atomic<uint32_t> tail;
+        alignas(128) std::atomic<uint64_t> freeTop;    //  << 32 |  
+        Slot slots[MAX_PARTICIPANTS];
+    };
+
+    const std::string name;
+    int fd = -1;
+    size_t length = 0;
+    Header* header = nullptr;
+    Node* nodes = nullptr;              // nodes[0]  
+
+    const int kHpHead = 0;              //   pop,   push
+    const int kHpNext = 1;
+
+    static size_t segmentSize(uint32_t capacity) {
+        // capacity  +   +  
+        return sizeof(Header) + sizeof(Node) * ((size_t)capacity + 2);
+    }
+
+    Node& node(uint32_t offset) {
+        return nodes[offset];
+    }
+
+    uint32_t protect(int index, const std::atomic<uint32_t>& atom, Slot& slot) {
+        uint32_t offset = atom.load();
+        while (true) {
+            slot.hazard[index].store(offset);
+            uint32_t again = atom.load();
+            if (again == offset) return offset;
+            offset = again;
+        }
+    }
+
+    void clear(Slot& slot) {
+        for (int i = 0; i < HPS; i++)
+            slot.hazard[i].store(0, std::memory_order_release);
+    }
+
+    void freePush(uint32_t offset) {
+        uint64_t top = header->freeTop.load();
+        do {
+            node(offset).next.store((uint32_t)top, std::memory_order_relaxed);
+        } while (!header->freeTop.compare_exchange_weak(top, (((top >> 32) + 1) << 32) | offset));
+    }
+
+    uint32_t freePop() {
+        uint64_t top = header->freeTop.load();
+        while ((uint32_t)top != 0) {
+            uint32_t next = node((uint32_t)top).next.load();
+            if (header->freeTop.compare_exchange_weak(top, (((top >> 32) + 1) << 32) | next)) return (uint32_t)top;
+        }
+        return 0;
+    }
+
+    //      ,     
+    void scan(Slot& slot) {
+        uint32_t hazards[MAX_PARTICIPANTS * HPS];
+        int count = 0;
+        for (int i = 0; i < MAX_PARTICIPANTS; i++)
+            for (int j = 0; j < HPS; j++) {
+                uint32_t offset = header->slots[i].hazard[j].load();
+                if (offset != 0) hazards[count++] = offset;
+            }
+        std::sort(hazards, hazards + count);
+        uint32_t i = 0;
+        while (i < slot.retiredCount.load()) {
+            uint32_t offset = slot.retired[i].load();
+            if (std::binary_search(hazards, hazards + count, offset)) {
+                i++;
+                continue;
+            }
+            //   ,     scan   ,
+            //        
+            uint32_t last = slot.retiredCount.load() - 1;
+            uint32_t moved = slot.retired[last].load();
+            slot.retiredCount.store(last);
+            slot.retired[i].store(moved);
+            freePush(offset);
+        }
+    }
+
+    void retire(uint32_t offset, Slot& slot) {
+        uint32_t count = slot.retiredCount.load();
+        slot.retired[count].store(offset);
+        slot.retiredCount.store(count + 1);
+        scan(slot);
+    }
+
+    Slot& slotOf(const int participant) {
+        if (participant < 0 || participant >= MAX_PARTICIPANTS) throw std::out_of_range("participant out of range");
+        return header->slots[participant];
+    }
+
+    //    PID   ( inode /proc/self/ns/pid).
+    //  /proc      .
+    static uint64_t currentPidNamespace() {
+#ifdef __linux__
+        struct stat info;
+        if (stat("/proc/self/ns/pid", &info) == 0) return (uint64_t)info.st_ino;
+#endif
+        return 1;
+    }
+
+    void initialize(uint32_t capacity) {
+        header->capacity = capacity;
+        header->itemSize = sizeof(T);
+        for (int i = 0; i < MAX_PARTICIPANTS; i++) {
+            Slot& slot = header->slots[i];
+            slot.pid.store(0, std::memory_order_relaxed);
+            slot.pidNamespace.store(UNKNOWN_NAMESPACE, std::memory_order_relaxed);
+            for (int j = 0; j < HPS; j++)
+                slot.hazard[j].store(0, std::memory_order_relaxed);
+            slot.retiredCount.store(0, std::memory_order_relaxed);
+        }
+        //  1 - ,  -   
+        node(1).next.store(0, std::memory_order_relaxed);
+        header->head.store(1, std::memory_order_relaxed);
+        header->tail.store(1, std::memory_order_relaxed);
+        for (uint32_t i = 2; i <= capacity + 1; i++)
+            node(i).next.store(i == capacity + 1 ? 0 : i + 1, std::memory_order_relaxed);
+        header->freeTop.store(capacity > 0 ? 2 : 0, std::memory_order_relaxed);
+        header->magic.store(MAGIC, std::memory_order_release);
+    }
+
+    // ,       .    - .
+    void waitForCreator(std::chrono::steady_clock::time_point deadline) {
+        if (std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+            return;
+        }
+        if (header != nullptr) munmap(header, length);
+        close(fd);
+        throw std::runtime_error("shared memory segment " + name + " was not initialized in time");
+    }
+
+    void map(size_t size) {
+        void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+        length = size;
+        header = (Header*)address;
+        nodes = (Node*)((char*)address + sizeof(Header));
+    }
+
+public:
+    //   name  capacity      (capacity   ).
+    // initTimeout -      .
+    ShmQueue(const std::string& name, uint32_t capacity = 4096,
+             std::chrono::milliseconds initTimeout = std::chrono::milliseconds(5000)) : name{ name } {
+        if (capacity == 0 || capacity > 0x7FFFFFFEu) throw std::invalid_argument("capacity out of range");
+        fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) {
+            if (ftruncate(fd, (off_t)segmentSize(capacity)) < 0) {
+                int error = errno;
+                close(fd);
+                shm_unlink(name.c_str());
+                throw std::system_error(error, std::generic_category(), "ftruncate");
+            }
+            map(segmentSize(capacity));
+            initialize(capacity);
+            return;
+        }
+        if (errno != EEXIST) throw std::system_error(errno, std::generic_category(), "shm_open");
+
+        fd = shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "shm_open");
+        //          
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + initTimeout;
+        struct stat info;
+        do {
+            if (fstat(fd, &info) < 0) {
+                int error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(), "fstat");
+            }
+            if (info.st_size == 0) waitForCreator(deadline);
+        } while (info.st_size == 0);
+        map((size_t)info.st_size);
+        while (header->magic.load(std::memory_order_acquire) != MAGIC) waitForCreator(deadline);
+        if (header->itemSize != sizeof(T) || segmentSize(header->capacity) != length) {
+            munmap(header, length);
+            close(fd);
+            throw std::invalid_argument("segment layout does not match ShmQueue<T>");
+        }
+    }
+
+    //   ;     unlink
+    ~ShmQueue() {
+        munmap(header, length);
+        close(fd);
+    }
+
+    ShmQueue(const ShmQueue&) = delete;
+    ShmQueue& operator=(const ShmQueue&) = delete;
+
+    //   ;    
+    static void unlink(const std::string& name) {
+        shm_unlink(name.c_str());
+    }
+
+    //      .      :
+    //   ,  runtime_error,    recoverDead   .
+    int attach() {
+        const int32_t pid = (int32_t)getpid();
+        for (int i = 0; i < MAX_PARTICIPANTS; i++) {
+            int32_t expected = 0;
+            if (header->slots[i].pid.compare_exchange_strong(expected, pid)) {
+                header->slots[i].pidNamespace.store(currentPidNamespace());
+                return i;
+            }
+        }
+        throw std::runtime_error("no free participant slots");
+    }
+
+    void detach(const int participant) {
+        Slot& slot = slotOf(participant);
+        clear(slot);
+        scan(slot);
+        slot.pidNamespace.store(UNKNOWN_NAMESPACE);
+        slot.pid.store(0);
+    }
+
+    //   ,   .    .
+    //       PID  ; pid,  
+    //   ,   .
+    int recoverDead() {
+        const uint64_t ownNamespace = currentPidNamespace();
+        int recovered = 0;
+        for (int i = 0; i < MAX_PARTICIPANTS; i++) {
+            Slot& slot = header->slots[i];
+            int32_t pid = slot.pid.load();
+            if (pid <= 0 || slot.pidNamespace.load() != ownNamespace) continue;
+            if (kill(pid, 0) == 0 || errno != ESRCH) continue;
+            if (!slot.pid.compare_exchange_strong(pid, RECOVERING)) continue;
+            clear(slot);
+            scan(slot);
+            slot.pidNamespace.store(UNKNOWN_NAMESPACE);
+            slot.pid.store(0);
+            recovered++;
+        }
+        return recovered;
+    }
+
+    // false -    (  capacity     )
+    bool push(const T& item, const int participant) {
+        Slot& slot = slotOf(participant);
+        uint32_t offset = freePop();
+        if (offset == 0) {
+            scan(slot);
+            offset = freePop();
+            if (offset == 0) return false;
+        }
+        node(offset).item = item;
+        node(offset).next.store(0, std::memory_order_relaxed);
+        while (true) {
+            uint32_t ltail = protect(kHpHead, header->tail, slot);
+            uint32_t lnext = node(ltail).next.load();
+            if (header->tail.load() != ltail) continue;
+            if (lnext != 0) {
+                header->tail.compare_exchange_strong(ltail, lnext);
+                continue;
+            }
+            uint32_t expected = 0;
+            if (node(ltail).next.compare_exchange_strong(expected, offset)) {
+                header->tail.compare_exchange_strong(ltail, offset);
+                break;
+            }
+        }
+        clear(slot);
+        return true;
+    }
+
+    //    item. false -  .
+    bool pop(T& item, const int participant) {
+        Slot& slot = slotOf(participant);
+        while (true) {
+            uint32_t lhead = protect(kHpHead, header->head, slot);
+            uint32_t ltail = header->tail.load();
+            uint32_t lnext = node(lhead).next.load();
+            slot.hazard[kHpNext].store(lnext);
+            if (header->head.load() != lhead) continue;
+            if (lnext == 0) {
+                clear(slot);
+                return false;
+            }
+            if (lhead == ltail) {
+                header->tail.compare_exchange_strong(ltail, lnext);
+                continue;
+            }
+            T value = node(lnext).item;
+            if (header->head.compare_exchange_strong(lhead, lnext)) {
+                clear(slot);
+                retire(lhead, slot);
+                item = value;
+                return true;
+            }
+        }
+    }
+
+    bool isEmpty() {
+        return header->head.load() == header->tail.load();
+    }
+
+    uint32_t getCapacity() const {
+        return header->capacity;
+    }
+
+    const std::string& getName() const {
+        return name;
+    }
+};
+
+#endif
+#endif
\ No newline at end of file
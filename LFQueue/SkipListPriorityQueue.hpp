@@ -0,0 +1,278 @@
+#ifndef _SKIP_LIST_PRIORITY_QUEUE_H_
+#define _SKIP_LIST_PRIORITY_QUEUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "HazardPointers.hpp"
+
+
+template<typename K, typename T, typename Compare = std::less<K>>
+class SkipListPriorityQueue {
+    /*
+    //         (Linden, Jonsson, 2013).
+    // pop      (,  ).
+    //
+    //   :        next[0]  ,
+    //        ,  pop    
+    //  CAS.    :  pop   boundOffset  ,
+    //    ,   ,     HazardPointers.
+    //      ,     pop   .
+    //
+    //    ,   (   , 
+    //  ).     version.    
+    // Hazard Pointer         ,  version :
+    // ,    version,     .
+    //
+    // K      (  ).    
+    //    .
+    */
+private:
+    static const int MAX_LEVEL = 24;
+
+    struct Node {
+        const K key;
+        T* const item;
+        const int levels;
+        std::atomic<bool> inserting;        //      
+        std::atomic<Node*>* next;           //   next[0] -   
+
+        Node(const K& key, T* item, int levels) : key(key), item{ item }, levels{ levels }, inserting{ true },
+            next{ new std::atomic<Node*>[levels] } {
+            for (int i = 0; i < levels; i++)
+                next[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        Node() : key(), item{ nullptr }, levels{ MAX_LEVEL }, inserting{ false }, next{ new std::atomic<Node*>[MAX_LEVEL] } {
+            for (int i = 0; i < levels; i++)
+                next[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        ~Node() {
+            delete[] next;
+        }
+    };
+
+    static const int MAX_THREADS = 128;
+    const int maxThreads;
+    const int boundOffset;
+    Compare less;
+
+    Node* const head;
+    alignas(128) std::atomic<unsigned long long> version{ 0 };     //   
+    alignas(128) std::atomic<bool> restructuring{ false };
+
+    HazardPointers<Node> hp{ 2, maxThreads };
+    const int kHpPred = 0;
+    const int kHpSucc = 1;
+
+    static bool isMarked(Node* node) {
+        return ((uintptr_t)node & 1) != 0;
+    }
+
+    static Node* marked(Node* node) {
+        return (Node*)((uintptr_t)node | 1);
+    }
+
+    static Node* unmarked(Node* node) {
+        return (Node*)((uintptr_t)node & ~(uintptr_t)1);
+    }
+
+    //    :    p = 1/2
+    int randomLevel(const int tid) {
+        thread_local uint32_t state = 0;
+        if (state == 0) state = 2654435761u * (uint32_t)(tid + 1);
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        int levels = 1;
+        for (uint32_t bits = state; (bits & 1) != 0 && levels < MAX_LEVEL; bits >>= 1)
+            levels++;
+        return levels;
+    }
+
+    //  ,    version == observed. false -  ,   .
+    bool protectFound(Node* pred, Node* succ, unsigned long long observed, const int tid) {
+        hp.protectPtr(kHpPred, pred, tid);
+        hp.protectPtr(kHpSucc, succ, tid);
+        return version.load() == observed;
+    }
+
+    //    key   .      .
+    //      ,   ,  nullptr.
+    Node* locatePreds(const K& key, Node** preds, Node** succs, unsigned long long& observed, const int tid) {
+        while (true) {
+            observed = version.load();
+            Node* x = head;
+            Node* del = nullptr;
+            int hx = kHpPred, hn = kHpSucc;
+            bool restart = false;
+            for (int i = MAX_LEVEL - 1; i >= 0 && !restart; i--) {
+                Node* raw = x->next[i].load();
+                Node* xn = unmarked(raw);
+                hp.protectPtr(hn, xn, tid);
+                if (version.load() != observed) {
+                    restart = true;
+                    break;
+                }
+                while (xn != nullptr && (less(xn->key, key) || isMarked(xn->next[0].load()) || (i == 0 && isMarked(raw)))) {
+                    if (i == 0 && isMarked(raw)) del = xn;
+                    x = xn;
+                    std::swap(hx, hn);
+                    raw = x->next[i].load();
+                    xn = unmarked(raw);
+                    hp.protectPtr(hn, xn, tid);
+                    if (version.load() != observed) {
+                        restart = true;
+                        break;
+                    }
+                }
+                preds[i] = x;
+                succs[i] = xn;
+            }
+            if (!restart) return del;
+        }
+    }
+
+    //   :       
+    void restructureUpper() {
+        Node* pred = head;
+        int i = MAX_LEVEL - 1;
+        while (i > 0) {
+            Node* h = head->next[i].load();
+            if (h == nullptr || !isMarked(h->next[0].load())) {
+                i--;
+                continue;
+            }
+            Node* cur = pred->next[i].load();
+            while (cur != nullptr && isMarked(cur->next[0].load())) {
+                pred = cur;
+                cur = pred->next[i].load();
+            }
+            if (head->next[i].compare_exchange_strong(h, cur)) i--;
+        }
+    }
+
+    //     obsHead  newHead ( ),      
+    void tryRestructure(Node* obsHead, Node* newHead, unsigned long long observed, const int tid) {
+        if (restructuring.exchange(true)) return;
+        Node* expected = obsHead;
+        if (version.load() == observed && head->next[0].compare_exchange_strong(expected, marked(newHead))) {
+            restructureUpper();
+            version.fetch_add(1);
+            Node* cur = unmarked(obsHead);
+            while (cur != newHead) {
+                Node* next = unmarked(cur->next[0].load());
+                hp.retire(cur, tid);
+                cur = next;
+            }
+        }
+        restructuring.store(false);
+    }
+
+public:
+    // boundOffset -    pop ,     
+    SkipListPriorityQueue(int maxThreads = MAX_THREADS, int boundOffset = 32) : maxThreads{ maxThreads }, boundOffset{ boundOffset }, head{ new Node() } { }
+
+    ~SkipListPriorityQueue() {
+        Node* node = head;
+        while (node != nullptr) {
+            Node* next = unmarked(node->next[0].load());
+            delete node;
+            node = next;
+        }
+    }
+
+    SkipListPriorityQueue(const SkipListPriorityQueue&) = delete;
+    SkipListPriorityQueue& operator=(const SkipListPriorityQueue&) = delete;
+
+    void push(const K& key, T* item, const int tid) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        const int levels = randomLevel(tid);
+        Node* node = new Node(key, item, levels);
+        Node* preds[MAX_LEVEL];
+        Node* succs[MAX_LEVEL];
+        unsigned long long observed;
+        Node* del;
+
+        //     -   
+        while (true) {
+            del = locatePreds(key, preds, succs, observed, tid);
+            if (!protectFound(preds[0], succs[0], observed, tid)) continue;
+            node->next[0].store(succs[0], std::memory_order_relaxed);
+            Node* expected = succs[0];
+            if (preds[0]->next[0].compare_exchange_strong(expected, node)) break;
+        }
+
+        //  ; ,    
+        for (int i = 1; i < levels; ) {
+            if (isMarked(node->next[0].load())) break;
+            if (protectFound(preds[i], succs[i], observed, tid)) {
+                if (succs[i] != nullptr && (isMarked(succs[i]->next[0].load()) || succs[i] == del)) break;
+                node->next[i].store(succs[i]);
+                Node* expected = succs[i];
+                if (preds[i]->next[i].compare_exchange_strong(expected, node)) {
+                    i++;
+                    continue;
+                }
+            }
+            del = locatePreds(key, preds, succs, observed, tid);
+            if (succs[0] != node) break;
+        }
+        hp.clear(tid);
+        node->inserting.store(false);
+    }
+
+    //     , nullptr -  .  key ( ) -  .
+    T* pop(const int tid, K* key = nullptr) {
+        while (true) {
+            const unsigned long long observed = version.load();
+            Node* obsHead = head->next[0].load();
+            Node* newHead = nullptr;
+            Node* x = head;
+            int hx = kHpPred, hn = kHpSucc;
+            int offset = 0;
+            bool restart = false;
+            while (true) {
+                Node* raw = x->next[0].load();
+                Node* xn = unmarked(raw);
+                if (xn == nullptr) {
+                    hp.clear(tid);
+                    return nullptr;
+                }
+                if (newHead == nullptr && x->inserting.load()) newHead = x;
+                hp.protectPtr(hn, xn, tid);
+                if (version.load() != observed) {
+                    restart = true;
+                    break;
+                }
+                if (!isMarked(raw)) {
+                    //     xn;   next[0]     pop
+                    if (!x->next[0].compare_exchange_strong(raw, marked(xn))) continue;
+                    x = xn;
+                    break;
+                }
+                x = xn;
+                std::swap(hx, hn);
+                offset++;
+            }
+            if (restart) continue;
+
+            T* item = x->item;
+            if (key != nullptr) *key = x->key;
+            if (newHead == nullptr) newHead = x;
+            hp.clear(tid);
+            if (offset >= boundOffset) tryRestructure(obsHead, newHead, observed, tid);
+            return item;
+        }
+    }
+
+    //  ,      ()
+    size_t getRetiredCount() const {
+        return hp.getRetiredCount();
+    }
+};
+
+#endif
\ No newline at end of file
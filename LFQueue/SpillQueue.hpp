@@ -0,0 +1,223 @@
+#ifndef _SPILL_QUEUE_H_
+#define _SPILL_QUEUE_H_
+
+//  POSIX: mmap(2)
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "MSQueue.hpp"
+
+
+template<typename T, typename Codec>
+class SpillQueue {
+    /*
+    //      .      watermark ,
+    //   MSQueue.    watermark,     :
+    //     Codec    -,  mmap.
+    //    ,      .  
+    // ,         .
+    //
+    //      ,        , 
+    //      ,          .
+    //   ( ) -  MSQueue   .
+    //
+    // Codec:
+    //     size_t size(const T* item);                      //    
+    //     void encode(const T* item, char* out);
+    //     T* decode(const char* data, size_t size);        //  
+    // ,   ,  encode   delete; pop   decode.
+    //  -    directory,      ;  
+    //       (msync  ).
+    */
+private:
+    struct Segment {
+        std::string path;
+        int fd;
+        char* data;
+        size_t capacity;
+        size_t written;         //  
+        size_t read;            //  
+    };
+
+    static const int MAX_THREADS = 128;
+    static const size_t RECORD_HEADER = sizeof(uint32_t);      //     
+
+    MSQueue<T> memory;
+    Codec codec;
+    const std::string directory;
+    const int64_t watermark;
+    const size_t segmentBytes;
+
+    alignas(128) std::atomic<int64_t> memoryDepth{ 0 };
+    alignas(128) std::atomic<bool> spilling{ false };
+    std::atomic<uint64_t> spilledDepth{ 0 };
+    std::atomic<uint64_t> spilledTotal{ 0 };
+
+    std::mutex spillMutex;
+    std::deque<Segment> segments;       //  spillMutex
+    uint64_t segmentIndex = 0;
+
+    void openSegment(size_t capacity) {
+        Segment segment;
+        //       fork   ASLR,     pid.  
+        //   (O_EXCL):  ,     , .
+        while (true) {
+            segment.path = directory + "/spill-" + std::to_string((long long)getpid()) + "-"
+                + std::to_string((uintptr_t)this) + "-" + std::to_string(segmentIndex++) + ".seg";
+            segment.fd = open(segment.path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (segment.fd >= 0) break;
+            if (errno != EEXIST) throw std::system_error(errno, std::generic_category(), "open " + segment.path);
+        }
+        if (ftruncate(segment.fd, (off_t)capacity) < 0) {
+            int error = errno;
+            close(segment.fd);
+            unlink(segment.path.c_str());
+            throw std::system_error(error, std::generic_category(), "ftruncate " + segment.path);
+        }
+        void* address = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+        if (address == MAP_FAILED) {
+            int error = errno;
+            close(segment.fd);
+            unlink(segment.path.c_str());
+            throw std::system_error(error, std::generic_category(), "mmap " + segment.path);
+        }
+        segment.data = (char*)address;
+        segment.capacity = capacity;
+        segment.written = 0;
+        segment.read = 0;
+        segments.push_back(segment);
+    }
+
+    void closeSegment(Segment& segment) {
+        munmap(segment.data, segment.capacity);
+        close(segment.fd);
+        unlink(segment.path.c_str());
+    }
+
+    //       ( spillMutex)
+    void appendSpilled(T* item) {
+        size_t size = codec.size(item);
+        size_t record = RECORD_HEADER + size;
+        if (segments.empty() || segments.back().written + record > segments.back().capacity)
+            openSegment(record > segmentBytes ? record : segmentBytes);
+        Segment& segment = segments.back();
+        uint32_t length = (uint32_t)size;
+        memcpy(segment.data + segment.written, &length, RECORD_HEADER);
+        codec.encode(item, segment.data + segment.written + RECORD_HEADER);
+        segment.written += record;
+        spilledDepth.fetch_add(1);
+        spilledTotal.fetch_add(1);
+        delete item;
+    }
+
+    //      ( spillMutex).     .
+    T* readSpilled() {
+        while (!segments.empty()) {
+            Segment& segment = segments.front();
+            if (segment.read < segment.written) {
+                uint32_t length;
+                memcpy(&length, segment.data + segment.read, RECORD_HEADER);
+                T* item = codec.decode(segment.data + segment.read + RECORD_HEADER, length);
+                segment.read += RECORD_HEADER + length;
+                spilledDepth.fetch_sub(1);
+                return item;
+            }
+            closeSegment(segment);
+            segments.pop_front();
+        }
+        spilling.store(false);
+        return nullptr;
+    }
+
+public:
+    // watermark -     , segmentBytes -  -
+    SpillQueue(const std::string& directory, int64_t watermark, Codec codec = Codec(), size_t segmentBytes = 64 << 20,
+        int maxThreads = MAX_THREADS) : memory(maxThreads), codec(codec), directory{ directory }, watermark{ watermark },
+        segmentBytes{ segmentBytes } {
+        if (watermark <= 0) throw std::invalid_argument("watermark must be positive");
+    }
+
+    // ,   ,    
+    ~SpillQueue() {
+        for (Segment& segment : segments)
+            closeSegment(segment);
+    }
+
+    SpillQueue(const SpillQueue&) = delete;
+    SpillQueue& operator=(const SpillQueue&) = delete;
+
+    void push(T* item, const int tid) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        if (!spilling.load() && memoryDepth.load(std::memory_order_relaxed) < watermark) {
+            memoryDepth.fetch_add(1);
+            memory.push(item, tid);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(spillMutex);
+        if (!spilling.load()) {
+            if (memoryDepth.load() < watermark) {
+                memoryDepth.fetch_add(1);
+                memory.push(item, tid);
+                return;
+            }
+            spilling.store(true);
+        }
+        appendSpilled(item);
+    }
+
+    //  , nullptr -  
+    T* pop(const int tid) {
+        T* item = memory.pop(tid);
+        if (item != nullptr) {
+            memoryDepth.fetch_sub(1);
+            return item;
+        }
+        if (!spilling.load()) return nullptr;
+        std::lock_guard<std::mutex> lock(spillMutex);
+        //     :      
+        item = memory.pop(tid);
+        if (item != nullptr) {
+            memoryDepth.fetch_sub(1);
+            return item;
+        }
+        if (!spilling.load()) return nullptr;
+        return readSpilled();
+    }
+
+    bool isEmpty() {
+        return memory.isEmpty() && spilledDepth.load() == 0;
+    }
+
+    //    ()
+    int64_t getMemoryDepth() const {
+        return memoryDepth.load(std::memory_order_relaxed);
+    }
+
+    //   
+    uint64_t getSpilledDepth() const {
+        return spilledDepth.load(std::memory_order_relaxed);
+    }
+
+    //       
+    uint64_t getSpilledTotal() const {
+        return spilledTotal.load(std::memory_order_relaxed);
+    }
+
+    bool isSpilling() const {
+        return spilling.load();
+    }
+};
+
+#endif
+#endif
\ No newline at end of file
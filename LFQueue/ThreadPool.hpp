@@ -0,0 +1,161 @@
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "IntrusiveQueue.hpp"
+#include "CacheAligned.hpp"
+#include "EventCount.hpp"
+#include "ThreadRegistry.hpp"
+
+
+class ThreadPool {
+    /*
+    //      IntrusiveQueue:     ,
+    //  submit     .
+    // ,  ,     injection; ,   
+    // , -    .        ,   ,
+    //      .     spinCount ,
+    //      EventCount; submit   .
+    // tid    ThreadRegistry,     ,  submit.
+    // ,   ,  ,    std::thread.
+    */
+private:
+    //      ,      
+    // (. IntrusiveQueue),       ,     
+    struct Task : IntrusiveHook {
+        virtual ~Task() { }
+        virtual void run() = 0;
+    };
+
+    template<typename F>
+    struct TaskImpl : Task {
+        typename std::aligned_storage<sizeof(F), alignof(F)>::type storage;
+        bool pending = true;
+
+        template<typename G>
+        TaskImpl(G&& f) { new (&storage) F(std::forward<G>(f)); }
+
+        ~TaskImpl() {
+            if (pending) function().~F();
+        }
+
+        F& function() { return *reinterpret_cast<F*>(&storage); }
+
+        void run() override {
+            function()();
+            pending = false;
+            function().~F();
+        }
+    };
+
+    struct Worker : CacheAligned {
+        IntrusiveQueue<Task> local{ ThreadRegistry::MAX_THREADS };
+        std::thread thread;
+    };
+
+    IntrusiveQueue<Task> injection{ ThreadRegistry::MAX_THREADS };
+    std::vector<std::unique_ptr<Worker>> workers;
+    EventCount idle;
+    std::atomic<bool> stopping{ false };
+    const unsigned spinCount;
+
+    //    ,     
+    static std::pair<ThreadPool*, Worker*>& current() {
+        thread_local std::pair<ThreadPool*, Worker*> owner(nullptr, nullptr);
+        return owner;
+    }
+
+    Task* findTask(Worker* self, size_t selfIndex, const int tid) {
+        Task* task = self->local.pop(tid);
+        if (task != nullptr) return task;
+        task = injection.pop(tid);
+        if (task != nullptr) return task;
+        //   ,   
+        for (size_t i = 1; i < workers.size(); i++) {
+            task = workers[(selfIndex + i) % workers.size()]->local.pop(tid);
+            if (task != nullptr) return task;
+        }
+        return nullptr;
+    }
+
+    static void execute(Task* task) {
+        task->run();
+    }
+
+    void workerLoop(size_t index) {
+        Worker* self = workers[index].get();
+        current() = std::make_pair(this, self);
+        const int tid = ThreadRegistry::current();
+        while (true) {
+            Task* task = findTask(self, index, tid);
+            for (unsigned spin = 0; task == nullptr && spin < spinCount; spin++) {
+                std::this_thread::yield();
+                task = findTask(self, index, tid);
+            }
+            if (task != nullptr) {
+                execute(task);
+                continue;
+            }
+            uint64_t key = idle.prepareWait();
+            task = findTask(self, index, tid);
+            if (task != nullptr) {
+                idle.cancelWait();
+                execute(task);
+                continue;
+            }
+            if (stopping.load()) {
+                idle.cancelWait();
+                return;
+            }
+            idle.wait(key);
+        }
+    }
+
+public:
+    ThreadPool(unsigned threads = std::thread::hardware_concurrency(), unsigned spinCount = 64) : spinCount{ spinCount } {
+        if (threads == 0) threads = 1;
+        for (unsigned i = 0; i < threads; i++)
+            workers.emplace_back(new Worker());
+        for (unsigned i = 0; i < threads; i++)
+            workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+    }
+
+    //        .
+    //  submit        .
+    ~ThreadPool() {
+        stopping.store(true);
+        idle.notifyAll();
+        for (auto& worker : workers)
+            worker->thread.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned size() const {
+        return (unsigned)workers.size();
+    }
+
+    //  .      .
+    //           .
+    template<typename F>
+    void submit(F&& function) {
+        std::pair<ThreadPool*, Worker*>& owner = current();
+        if (owner.first != this && stopping.load(std::memory_order_relaxed))
+            throw std::logic_error("submit to a stopping pool");
+        Task* task = new TaskImpl<typename std::decay<F>::type>(std::forward<F>(function));
+        const int tid = ThreadRegistry::current();
+        if (owner.first == this) owner.second->local.push(task, tid);
+        else injection.push(task, tid);
+        idle.notifyOne();
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef _THREAD_REGISTRY_H_
+#define _THREAD_REGISTRY_H_
+
+#include <atomic>
+#include <stdexcept>
+
+
+class ThreadRegistry {
+    /*
+    //     (tid)  MSQueue  HazardPointers.
+    //    tid    current()     ,
+    //       .     ,
+    //  ,     ,   maxThreads = MAX_THREADS.
+    */
+public:
+    static const int MAX_THREADS = 128;    //    HazardPointers
+
+private:
+    std::atomic<bool> used[MAX_THREADS];
+
+    ThreadRegistry() {
+        for (int tid = 0; tid < MAX_THREADS; tid++)
+            used[tid].store(false, std::memory_order_relaxed);
+    }
+
+    struct Holder {
+        //  tid  thread_local,     
+        int tid;
+        Holder() : tid{ instance().acquire() } { }
+        ~Holder() { instance().release(tid); }
+    };
+
+public:
+    static ThreadRegistry& instance() {
+        static ThreadRegistry registry;
+        return registry;
+    }
+
+    //   tid.    - .
+    int acquire() {
+        for (int tid = 0; tid < MAX_THREADS; tid++) {
+            bool expected = false;
+            if (!used[tid].load(std::memory_order_relaxed) && used[tid].compare_exchange_strong(expected, true))
+                return tid;
+        }
+        throw std::runtime_error("too many threads registered");
+    }
+
+    void release(const int tid) {
+        used[tid].store(false, std::memory_order_release);
+    }
+
+    // tid  
+    static int current() {
+        thread_local Holder holder;
+        return holder.tid;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,152 @@
+#ifndef _TREIBER_STACK_H_
+#define _TREIBER_STACK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include "HazardPointers.hpp"
+#include "CacheAligned.hpp"
+
+
+template<typename T>
+class TreiberStack {
+    /*
+    //    (LIFO)    (Hendler, Shavit, Yerushalmi, 2004).
+    //     , top     .
+    //    HazardPointers,  ABA  top .
+    //
+    //  CAS  top  ,     ,       :
+    // push        spinCount , pop   .
+    //  push  pop  ,    top,     
+    //       ,      .
+    //   , push    Hazard Pointer:  pop    ,
+    //            push      .
+    //
+    // eliminationWidth = 0    (  ).
+    */
+private:
+    struct Node {
+        T* item;                    //   
+        Node* next;                 //  ;     
+
+        Node(T* userItem) : item{ userItem }, next{ nullptr } { }
+    };
+
+    struct alignas(128) Slot : CacheAligned {
+        std::atomic<Node*> offer{ nullptr };    // ,  push,  nullptr
+    };
+
+    alignas(128) std::atomic<Node*> top{ nullptr };
+
+    static const int MAX_THREADS = 128;
+    const int maxThreads;
+    const unsigned eliminationWidth;
+    const unsigned spinCount;
+    std::unique_ptr<Slot[]> slots;
+
+    HazardPointers<Node> hp{ 2, maxThreads };
+    const int kHpTop = 0;
+    const int kHpOffer = 1;
+
+    //     (xorshift  )
+    Slot& randomSlot(const int tid) {
+        thread_local uint32_t state = 0;
+        if (state == 0) state = 2654435761u * (uint32_t)(tid + 1);
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return slots[state % eliminationWidth];
+    }
+
+    //     . true -   pop.
+    bool eliminatePush(Node* node, const int tid) {
+        if (eliminationWidth == 0) return false;
+        Slot& slot = randomSlot(tid);
+        Node* expected = nullptr;
+        hp.protectPtr(kHpOffer, node, tid);
+        if (!slot.offer.compare_exchange_strong(expected, node)) {
+            hp.clearOne(kHpOffer, tid);
+            return false;
+        }
+        for (unsigned spin = 0; spin < spinCount; spin++)
+            if (slot.offer.load(std::memory_order_acquire) != node) break;
+        //  ;   ,   
+        expected = node;
+        bool taken = !slot.offer.compare_exchange_strong(expected, nullptr);
+        hp.clearOne(kHpOffer, tid);
+        return taken;
+    }
+
+    //  ,  push   ,  nullptr
+    Node* eliminatePop(const int tid) {
+        if (eliminationWidth == 0) return nullptr;
+        Slot& slot = randomSlot(tid);
+        Node* node = slot.offer.load(std::memory_order_acquire);
+        if (node != nullptr && slot.offer.compare_exchange_strong(node, nullptr)) return node;
+        return nullptr;
+    }
+
+public:
+    TreiberStack(int maxThreads = MAX_THREADS, unsigned eliminationWidth = 8, unsigned spinCount = 128)
+        : maxThreads{ maxThreads }, eliminationWidth{ eliminationWidth }, spinCount{ spinCount },
+          slots{ new Slot[eliminationWidth > 0 ? eliminationWidth : 1] } { }
+
+    ~TreiberStack() {
+        Node* node = top.load();
+        while (node != nullptr) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    TreiberStack(const TreiberStack&) = delete;
+    TreiberStack& operator=(const TreiberStack&) = delete;
+
+    void push(T* item, const int tid) {
+        if (item == nullptr) throw std::invalid_argument("item can not be nullptr");
+        Node* node = new Node(item);
+        while (true) {
+            Node* ltop = top.load();
+            node->next = ltop;
+            if (top.compare_exchange_strong(ltop, node)) return;
+            if (eliminatePush(node, tid)) return;
+        }
+    }
+
+    //  , nullptr -  
+    T* pop(const int tid) {
+        while (true) {
+            Node* ltop = hp.protect(kHpTop, top, tid);
+            if (ltop == nullptr) {
+                hp.clearOne(kHpTop, tid);
+                return nullptr;
+            }
+            if (top.compare_exchange_strong(ltop, ltop->next)) {
+                hp.clearOne(kHpTop, tid);
+                T* item = ltop->item;
+                hp.retire(ltop, tid);
+                return item;
+            }
+            hp.clearOne(kHpTop, tid);
+            Node* node = eliminatePop(tid);
+            if (node != nullptr) {
+                T* item = node->item;
+                hp.retire(node, tid);
+                return item;
+            }
+        }
+    }
+
+    bool isEmpty() const {
+        return top.load() == nullptr;
+    }
+
+    //  ,      ()
+    size_t getRetiredCount() const {
+        return hp.getRetiredCount();
+    }
+};
+
+#endif
\ No newline at end of file
@@ -5,9 +5,12 @@
 #include "LFQueue/MSQueueTests.hpp"
 
 
-int main() {
+int main(int argc, char* argv[]) {
 	setlocale(LC_ALL, "Russian");
 
+	//       JSON: LockFreeQueue --json <> ...
+	if (argc > 1) return QueueBenchmarks::runFromArgs(argc, argv);
+
 	new MSQueueTests();
 
 	return 0;